@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+
+/**
+ * Two entity slots whose bounds may overlap.
+ */
+struct CandidatePair {
+    uint32_t a;
+    uint32_t b;
+};
+
+/**
+ * Selectable broad-phase backends.
+ */
+enum class BroadphaseType {
+    Grid,             // LayeredSpatialHash: uniform cells, partitioned by layer
+    SweepAndPrune,    // Sorted intervals along x; copes with clumped entities
+    HierarchicalGrid  // One grid level per entity size class
+};
+
+/**
+ * Common interface of the broad-phase structures, so EntityManager can
+ * switch between them at runtime.
+ *
+ * Entities are identified by their slot in EntityComponents. A backend
+ * either rebuilds from Clear + Insert every frame or, when IsIncremental()
+ * is true, expects Update/Remove for every slot and Truncate at the end.
+ */
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    virtual const char* GetName() const = 0;
+
+    /**
+     * @return True if the backend wants Update/Remove/Truncate each frame
+     *         instead of Clear + Insert
+     */
+    virtual bool IsIncremental() const = 0;
+
+    /**
+     * Remove every entity.
+     */
+    virtual void Clear() = 0;
+
+    /**
+     * Add an entity for this frame.
+     * @param slot Entity's slot index in EntityComponents
+     * @param position Entity position
+     * @param radius Entity radius
+     * @param layer Entity's collision layers (LAYER_NONE = never paired)
+     * @param mask Layers the entity collides with
+     */
+    virtual void Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) = 0;
+
+    /**
+     * Refresh a slot's bounds and layers, inserting it if absent.
+     */
+    virtual void Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) = 0;
+
+    /**
+     * Take a slot out (no-op if absent).
+     */
+    virtual void Remove(uint32_t slot) = 0;
+
+    /**
+     * Remove every slot >= slotCount, e.g. after the component arrays shrank.
+     */
+    virtual void Truncate(uint32_t slotCount) = 0;
+
+    /**
+     * Find every pair that may collide, once each. Pairs whose layers and
+     * masks can't match may be skipped but aren't guaranteed to be.
+     * @param pairs Cleared, then filled; its capacity is reused between frames
+     */
+    virtual void CollectCandidatePairs(std::vector<CandidatePair>& pairs) = 0;
+};
@@ -1,24 +1,25 @@
 #pragma once
 #include "Entity.h"
+#include "EntityManager.h"
 #include "Logger.h"
 
-class Bullet : public Entity
+class Bullet final : public Entity
 {
 public:
     Bullet(Vector2 position, Vector2 velocity, float damage,
            uint32_t collisionLayer, uint32_t collisionMask,
            Entity* owner = nullptr)
-        : Entity(position, 5.0f, collisionLayer, collisionMask, owner),
-          m_velocity(velocity), m_damage(damage) {}
-
-    void Update(float deltaTime) override
+        : Entity(EntityKindOf<Bullet>, position, 5.0f, collisionLayer, collisionMask, owner),
+          m_damage(damage)
     {
-        m_position.x += m_velocity.x * deltaTime;
-        m_position.y += m_velocity.y * deltaTime;
+        SetVelocity(velocity);
+    }
 
-        // Kill bullet if it goes off-screen
-        if (m_position.x < 0 || m_position.x > 1280 ||
-            m_position.y < 0 || m_position.y > 720)
+    void Update(float) override
+    {
+        // Movement is integrated by the manager's movement pass; all
+        // that's left is killing the bullet once it leaves the world
+        if (EntityManager::getInstance().isOutsideWorld(GetPosition()))
         {
             Kill();
         }
@@ -26,16 +27,16 @@ public:
 
     void Draw() const override
     {
-        if (m_alive)
+        if (IsAlive())
         {
-            DrawCircleV(m_position, m_radius, YELLOW);
+            DrawCircleV(GetRenderPosition(), GetRadius(), YELLOW);
         }
     }
 
     void OnCollision(Entity* other) override
     {
         // Don't collide with owner
-        if (other == m_owner) return;
+        if (other->GetHandle() == m_owner) return;
 
         // Bullet is destroyed on any collision
         Kill();
@@ -43,7 +44,12 @@ public:
 
     float GetDamage() const override { return m_damage; }
 
+    // Bullets only read their own position and kill themselves
+    static constexpr bool PARALLEL_UPDATE = true;
+
+    // Fast enough to pass through an enemy between two ticks
+    static constexpr bool CONTINUOUS_COLLISION = true;
+
 private:
-    Vector2 m_velocity;
     float m_damage;
 };
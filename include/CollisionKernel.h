@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Broadphase.h"
+#include "raylib.h"
+
+/**
+ * Flat component arrays the narrow phase reads, indexed by slot.
+ */
+struct CollisionArrays {
+    const Vector2* position;
+    const float* radius;
+    const uint32_t* layer;
+    const uint32_t* mask;
+};
+
+/**
+ * Batched narrow-phase test: layer/mask filter plus circle overlap for
+ * several candidate pairs at once.
+ *
+ * Uses AVX2 (8 pairs per instruction, hardware gathers) when the build
+ * targets it, SSE2 (two groups of 4) on any other x86-64 build, and a
+ * scalar loop elsewhere (see SimdIsa.h). Every path gives the same bits as
+ * the scalar test.
+ */
+class CollisionKernel {
+public:
+    static constexpr size_t BATCH_SIZE = 8;
+
+    /**
+     * Result of one batch; bit i refers to pairs[i].
+     */
+    struct Result {
+        uint32_t filtered;  // Layers and masks match both ways
+        uint32_t hits;      // Filtered and the circles overlap
+    };
+
+    /**
+     * @return Name of the instruction set the kernel was built for
+     */
+    static const char* GetName();
+
+    /**
+     * Test up to BATCH_SIZE pairs.
+     * @param arrays Component arrays the pairs' slots index into
+     * @param pairs First pair of the batch
+     * @param count Number of pairs, 1..BATCH_SIZE
+     */
+    static Result TestPairs(const CollisionArrays& arrays, const CandidatePair* pairs, size_t count);
+
+    /**
+     * Swept test for two circles moving in straight lines over one tick.
+     * @param startA, endA First circle's centre at the start and end of the tick
+     * @param startB, endB Second circle's centre at the start and end of the tick
+     * @param radiusSum Sum of both radii
+     * @param outTime Fraction of the tick (0..1) at which they first touch
+     * @return True if the circles touch during the tick
+     */
+    static bool SweptTimeOfImpact(Vector2 startA, Vector2 endA, Vector2 startB, Vector2 endB,
+                                  float radiusSum, float& outTime);
+};
@@ -1,11 +1,15 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <memory>
 #include <unordered_map>
 #include <vector>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include "raylib.h"
-
-// Forward declaration
-class Entity;
+#include "Broadphase.h"
+#include "CollisionKernel.h"
 
 // Collision layer definitions using bitflags
 // Each entity can belong to one or more layers
@@ -26,10 +30,55 @@ enum CollisionLayer : uint32_t {
     LAYER_ALL = 0xFFFFFFFF
 };
 
+/**
+ * Read-only view of the slot indices stored in one cell.
+ * Valid until the next Clear/Insert on the owning SpatialHash.
+ */
+struct CellSpan {
+    const uint32_t* first = nullptr;
+    const uint32_t* last = nullptr;
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * An entity a segment query touched.
+ */
+struct SegmentHit {
+    uint32_t slot;
+    float distance;  // From the segment start to where it first touches the entity
+};
+
+/**
+ * How SpatialHash keeps up with moving entities.
+ */
+enum class SpatialHashMode {
+    Rebuild,     // Clear + Insert everything each frame, counting-sorted into CSR
+    Incremental  // Per-cell buckets; Update only moves entities whose cells changed
+};
+
 /**
  * Spatial hash grid for efficient broad-phase collision detection.
  * Divides the world into cells and only checks entities in nearby cells.
  * This reduces collision checks from O(n²) to approximately O(n).
+ *
+ * An entity is stored in every cell its bounding box overlaps, so the cell
+ * size can be tuned for the small, numerous entities (bullets) without large
+ * ones (sword swings) missing contacts. Queries skip the repeats this causes.
+ *
+ * Inside the optional world bounds, cells form a dense grid stored in CSR
+ * layout: one contiguous array of slot indices sorted by cell (counting sort)
+ * plus a per-cell start offset. Every array keeps its capacity across
+ * frames, so a rebuild is a few linear passes with no heap traffic once
+ * warmed up. Positions outside the bounds (or everything, when no bounds are
+ * set) fall back to a hash map of per-cell vectors for unbounded worlds.
+ *
+ * In Incremental mode the dense cells are individual buckets instead and
+ * each slot remembers the cells it occupies, so entities that stay put cost
+ * one cell-range comparison per frame and removal is a swap-and-pop.
  */
 class SpatialHash {
 public:
@@ -40,6 +89,33 @@ public:
      */
     explicit SpatialHash(float cellSize = 100.0f);
 
+    /**
+     * Change the cell size. Keeps the current world bounds and empties the grid.
+     * @param cellSize Size of each grid cell in pixels
+     */
+    void SetCellSize(float cellSize);
+
+    /**
+     * Cover a fixed world rectangle with the dense grid.
+     * @param bounds World area in pixels; anything outside uses the fallback map
+     */
+    void SetBounds(Rectangle bounds);
+
+    /**
+     * Drop the dense grid; every cell goes through the fallback map.
+     */
+    void ClearBounds();
+
+    /**
+     * Switch between rebuilding every frame and incremental updates.
+     * Empties the grid.
+     */
+    void SetMode(SpatialHashMode mode);
+    SpatialHashMode GetMode() const { return m_mode; }
+
+    bool IsBounded() const { return m_cols > 0; }
+    float GetCellSize() const { return m_cellSize; }
+
     /**
      * Clear all entities from the spatial hash.
      * Call this at the beginning of each collision detection frame.
@@ -47,23 +123,177 @@ public:
     void Clear();
 
     /**
-     * Insert an entity into the spatial hash based on its position.
-     * @param entity Pointer to entity to insert
+     * Insert an entity into every cell its bounding box overlaps.
+     * @param slot Entity's slot index in EntityComponents
+     * @param position Entity position
+     * @param radius Entity radius (0 = stored in the centre cell only)
      */
-    void Insert(Entity* entity);
+    void Insert(uint32_t slot, Vector2 position, float radius = 0.0f);
 
     /**
-     * Query all entities within a radius of a position.
-     * Checks the cell containing the position plus all 8 neighboring cells.
+     * Incremental mode: place a slot in the cells for its current bounds,
+     * moving it only if they differ from where it is now. Inserts the slot
+     * if it isn't present. Same as Insert in Rebuild mode.
+     * @param slot Entity's slot index in EntityComponents
+     * @param position Entity position
+     * @param radius Entity radius
+     */
+    void Update(uint32_t slot, Vector2 position, float radius);
+
+    /**
+     * Incremental mode: take a slot out of all its cells (no-op if absent).
+     * @param slot Slot index to remove
+     */
+    void Remove(uint32_t slot);
+
+    /**
+     * Incremental mode: remove every slot >= slotCount, e.g. after the
+     * component arrays shrank.
+     * @param slotCount Number of slots still in use
+     */
+    void Truncate(uint32_t slotCount);
+
+    /**
+     * Sort the inserted entities into the dense grid.
+     * Called automatically by the first query after an Insert.
+     */
+    void Build();
+
+    /**
+     * Query all entities whose cells overlap a circle's bounding box.
+     * Each entity is reported once even if it spans several cells.
      * @param position Center position to query
      * @param radius Search radius
-     * @return Vector of entity pointers in the queried area
+     * @return Vector of entity slot indices in the queried area
+     */
+    std::vector<uint32_t> QueryRadius(Vector2 position, float radius);
+
+    /**
+     * Same as QueryRadius, but fills a caller-owned buffer so its capacity
+     * is reused between queries.
+     * @param results Cleared, then filled with entity slot indices
      */
-    std::vector<Entity*> QueryRadius(Vector2 position, float radius);
+    void QueryRadius(Vector2 position, float radius, std::vector<uint32_t>& results);
+
+    /**
+     * Visit the cell spans a radius query covers, without copying anything.
+     * An entity spanning several of these cells appears in each of them.
+     * @param visit Called as visit(CellSpan) for each non-empty cell
+     */
+    template<typename Visitor>
+    void ForEachCellInRadius(Vector2 position, float radius, Visitor&& visit);
+
+    /**
+     * Visit every entity slot a radius query covers, in place, once each.
+     * Not reentrant: don't start another query from inside the visitor.
+     * @param visit Called as visit(uint32_t slot)
+     */
+    template<typename Visitor>
+    void ForEachInRadius(Vector2 position, float radius, Visitor&& visit);
+
+    /**
+     * Walk the cells a segment crosses, in order from start to end (DDA).
+     * @param visit Called as visit(int32_t x, int32_t y, CellSpan cell,
+     *              float exitFraction) where exitFraction (0..1) is how far
+     *              along the segment it leaves the cell; return false to stop
+     */
+    template<typename Visitor>
+    void ForEachCellOnSegment(Vector2 start, Vector2 end, Visitor&& visit);
+
+    /**
+     * Find the entities a segment touches, walking only the cells it
+     * crosses. Not reentrant.
+     * @param position, radius Component arrays the stored slots index into
+     * @param accept Called as accept(uint32_t slot); false skips the slot
+     * @param firstHitOnly Stop at the nearest hit instead of collecting all
+     * @param hits Hits are appended, ordered by distance (then slot)
+     */
+    template<typename Accept>
+    void QuerySegment(Vector2 start, Vector2 end, const Vector2* position, const float* radius,
+                      Accept&& accept, bool firstHitOnly, std::vector<SegmentHit>& hits);
+
+    /**
+     * Slots stored in one cell (dense grid or fallback map).
+     * Call Build() first if entities were inserted since the last query.
+     */
+    CellSpan GetCell(int32_t x, int32_t y) const;
+
+    /**
+     * Enumerate every pair of entities that share a cell, once. A pair
+     * sharing several cells is only reported in the one holding the top-left
+     * corner of their bounding boxes' intersection.
+     * @param visit Called as visit(uint32_t slotA, uint32_t slotB)
+     */
+    template<typename Visitor>
+    void ForEachCandidatePair(Visitor&& visit);
+
+    /**
+     * Visit every non-empty cell: dense grid in row order, then the
+     * fallback cells in key order.
+     * @param visit Called as visit(int32_t x, int32_t y, CellSpan cell)
+     */
+    template<typename Visitor>
+    void ForEachCell(Visitor&& visit);
+
+    /**
+     * Top-left cell of the bounding box a slot was last inserted with.
+     * @param slot Slot index that is currently stored
+     */
+    void GetFirstCell(uint32_t slot, int32_t& outX, int32_t& outY) const {
+        outX = m_slotCells[slot].minX;
+        outY = m_slotCells[slot].minY;
+    }
 
 private:
+    // Cells covered by an inserted entity's bounding box (inclusive)
+    struct CellRange {
+        int32_t minX = 0;
+        int32_t minY = 0;
+        int32_t maxX = -1;
+        int32_t maxY = -1;
+        bool present = false;
+
+        bool SameCells(const CellRange& other) const {
+            return minX == other.minX && minY == other.minY &&
+                   maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+
+    SpatialHashMode m_mode;
     float m_cellSize;
-    std::unordered_map<int64_t, std::vector<Entity*>> m_grid;
+    Rectangle m_bounds;
+
+    // Dense grid: cell (x, y) with m_originX <= x < m_originX + m_cols, etc.
+    int32_t m_originX;
+    int32_t m_originY;
+    int32_t m_cols;
+    int32_t m_rows;
+
+    // Inserted since the last Build, in insertion order (one per covered cell)
+    std::vector<uint32_t> m_pendingSlots;
+    std::vector<uint32_t> m_pendingCells;
+
+    // CSR: slots of cell c are m_cellEntries[m_cellStart[c] .. m_cellStart[c + 1])
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellCursor;
+    std::vector<uint32_t> m_cellEntries;
+    bool m_built;
+
+    // Incremental mode: one bucket per dense cell
+    std::vector<std::vector<uint32_t>> m_cellBuckets;
+
+    // Fallback for cells outside the dense grid. Rebuild mode empties
+    // buckets on Clear so their storage is reused; Incremental mode erases
+    // a bucket as soon as its last slot leaves
+    std::unordered_map<int64_t, std::vector<uint32_t>> m_grid;
+    size_t m_overflowCount;
+    std::vector<int64_t> m_overflowKeys;  // Non-empty fallback cells, sorted by Build
+
+    // Per slot: covered cells (pair de-duplication, incremental moves) and
+    // the last query that reported it (query de-duplication)
+    std::vector<CellRange> m_slotCells;
+    std::vector<uint32_t> m_queryStamp;
+    uint32_t m_queryEpoch;
 
     /**
      * Hash a cell coordinate to a 64-bit integer key.
@@ -80,4 +310,423 @@ private:
      * @param outY Output cell y coordinate
      */
     void GetCellCoords(Vector2 pos, int32_t& outX, int32_t& outY) const;
+
+    /**
+     * @return Index of a cell in the dense grid, or -1 if it lies outside
+     */
+    int32_t DenseCellIndex(int32_t x, int32_t y) const;
+
+    CellRange ComputeCells(Vector2 position, float radius) const;
+    void EnsureSlot(uint32_t slot);
+    void InsertIntoCell(uint32_t slot, int32_t x, int32_t y);
+    void AddToBucket(uint32_t slot, int32_t x, int32_t y);
+    void RemoveFromBucket(uint32_t slot, int32_t x, int32_t y);
+
+    /**
+     * Start a de-duplicated query.
+     * @return Stamp marking slots already reported by this query
+     */
+    uint32_t BeginQuery();
+
+    /**
+     * Pairs within one cell whose shared-cell corner is this cell.
+     */
+    template<typename Visitor>
+    void VisitCellPairs(int32_t x, int32_t y, CellSpan cell, Visitor& visit) const;
 };
+
+template<typename Visitor>
+void SpatialHash::ForEachCellInRadius(Vector2 position, float radius, Visitor&& visit)
+{
+    Build();
+
+    // Every cell overlapping the query circle's bounding box
+    int32_t minX, minY, maxX, maxY;
+    GetCellCoords({ position.x - radius, position.y - radius }, minX, minY);
+    GetCellCoords({ position.x + radius, position.y + radius }, maxX, maxY);
+
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            CellSpan cell = GetCell(x, y);
+            if (!cell.empty()) {
+                visit(cell);
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+void SpatialHash::ForEachInRadius(Vector2 position, float radius, Visitor&& visit)
+{
+    Build();
+
+    const uint32_t stamp = BeginQuery();
+    uint32_t* seen = m_queryStamp.data();
+
+    ForEachCellInRadius(position, radius, [&visit, stamp, seen](CellSpan cell) {
+        for (uint32_t slot : cell) {
+            if (seen[slot] == stamp) continue;
+            seen[slot] = stamp;
+            visit(slot);
+        }
+    });
+}
+
+template<typename Visitor>
+void SpatialHash::ForEachCellOnSegment(Vector2 start, Vector2 end, Visitor&& visit)
+{
+    Build();
+
+    int32_t x, y, endX, endY;
+    GetCellCoords(start, x, y);
+    GetCellCoords(end, endX, endY);
+
+    // Amanatides-Woo: tMax is where the segment crosses the next cell
+    // boundary on each axis, tDelta how far apart those crossings are
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const int32_t stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    const int32_t stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+    const float never = 2.0f;  // Past the end of the segment
+    const float tDeltaX = stepX != 0 ? m_cellSize / std::fabs(dx) : never;
+    const float tDeltaY = stepY != 0 ? m_cellSize / std::fabs(dy) : never;
+    float tMaxX = stepX != 0 ? ((x + (stepX > 0 ? 1 : 0)) * m_cellSize - start.x) / dx : never;
+    float tMaxY = stepY != 0 ? ((y + (stepY > 0 ? 1 : 0)) * m_cellSize - start.y) / dy : never;
+
+    // Step count from the end cell, so float drift can't overshoot it
+    int32_t remaining = (endX > x ? endX - x : x - endX) + (endY > y ? endY - y : y - endY);
+    for (;;) {
+        float exitFraction = tMaxX < tMaxY ? tMaxX : tMaxY;
+        if (remaining == 0 || exitFraction > 1.0f) exitFraction = 1.0f;
+
+        if (!visit(x, y, GetCell(x, y), exitFraction) || remaining-- == 0) return;
+
+        if (tMaxX < tMaxY) {
+            x += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            y += stepY;
+            tMaxY += tDeltaY;
+        }
+    }
+}
+
+template<typename Accept>
+void SpatialHash::QuerySegment(Vector2 start, Vector2 end, const Vector2* position, const float* radius,
+                               Accept&& accept, bool firstHitOnly, std::vector<SegmentHit>& hits)
+{
+    Build();
+
+    const uint32_t stamp = BeginQuery();
+    uint32_t* seen = m_queryStamp.data();
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    const size_t firstNew = hits.size();
+
+    bool found = false;
+    SegmentHit nearest{ 0, 0.0f };
+    float nearestFraction = 0.0f;
+
+    ForEachCellOnSegment(start, end, [&](int32_t, int32_t, CellSpan cell, float exitFraction) {
+        for (uint32_t slot : cell) {
+            if (seen[slot] == stamp) continue;
+            seen[slot] = stamp;
+            if (!accept(slot)) continue;
+
+            // A segment is a circle sweeping from start to end with radius 0
+            float fraction;
+            if (!CollisionKernel::SweptTimeOfImpact(start, end, position[slot], position[slot],
+                                                     radius[slot], fraction)) continue;
+
+            SegmentHit hit{ slot, fraction * length };
+            if (!firstHitOnly) {
+                hits.push_back(hit);
+            } else if (!found || fraction < nearestFraction ||
+                       (fraction == nearestFraction && slot < nearest.slot)) {
+                found = true;
+                nearest = hit;
+                nearestFraction = fraction;
+            }
+        }
+
+        // Entities are stored in every cell they overlap, so anything the
+        // segment reaches before leaving this cell is already known
+        return !(found && nearestFraction < exitFraction);
+    });
+
+    if (firstHitOnly) {
+        if (found) hits.push_back(nearest);
+        return;
+    }
+    std::sort(hits.begin() + firstNew, hits.end(), [](const SegmentHit& a, const SegmentHit& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.slot < b.slot;
+    });
+}
+
+template<typename Visitor>
+void SpatialHash::VisitCellPairs(int32_t x, int32_t y, CellSpan cell, Visitor& visit) const
+{
+    const CellRange* cells = m_slotCells.data();
+
+    for (const uint32_t* a = cell.begin(); a != cell.end(); ++a) {
+        const CellRange& cellsA = cells[*a];
+        for (const uint32_t* b = a + 1; b != cell.end(); ++b) {
+            // Report the pair only in the first cell both bounding boxes cover
+            const CellRange& cellsB = cells[*b];
+            int32_t sharedX = cellsA.minX > cellsB.minX ? cellsA.minX : cellsB.minX;
+            int32_t sharedY = cellsA.minY > cellsB.minY ? cellsA.minY : cellsB.minY;
+            if (sharedX == x && sharedY == y) {
+                visit(*a, *b);
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+void SpatialHash::ForEachCandidatePair(Visitor&& visit)
+{
+    ForEachCell([this, &visit](int32_t x, int32_t y, CellSpan cell) {
+        if (cell.size() > 1) {
+            VisitCellPairs(x, y, cell, visit);
+        }
+    });
+}
+
+template<typename Visitor>
+void SpatialHash::ForEachCell(Visitor&& visit)
+{
+    Build();
+
+    for (int32_t row = 0; row < m_rows; ++row) {
+        for (int32_t col = 0; col < m_cols; ++col) {
+            CellSpan cell = GetCell(m_originX + col, m_originY + row);
+            if (!cell.empty()) {
+                visit(m_originX + col, m_originY + row, cell);
+            }
+        }
+    }
+
+    for (int64_t key : m_overflowKeys) {
+        int32_t x = static_cast<int32_t>(key >> 32);
+        int32_t y = static_cast<int32_t>(key & 0xFFFFFFFF);
+        visit(x, y, GetCell(x, y));
+    }
+}
+
+/**
+ * Broad phase split by collision layer: one SpatialHash per layer bit, so
+ * entities that can never collide are never in the same cell lists.
+ *
+ * Each entity is stored in the partition of its lowest layer bit; the
+ * partition tracks the union of its members' layers and masks. Pairs are
+ * only walked within a partition whose members can hit each other, and
+ * between two partitions whose layers and masks match both ways, so e.g.
+ * dense clouds of player bullets never test against each other. Radius
+ * queries only visit the partitions a mask selects.
+ *
+ * The unions are conservative (in Incremental mode they only reset on
+ * Clear), so callers still apply the exact layer/mask test per pair.
+ */
+class LayeredSpatialHash : public Broadphase {
+public:
+    static constexpr uint32_t LAYER_COUNT = 32;
+
+    explicit LayeredSpatialHash(float cellSize = 100.0f);
+
+    const char* GetName() const override { return "grid"; }
+    bool IsIncremental() const override { return m_mode == SpatialHashMode::Incremental; }
+
+    // Settings apply to every partition; see SpatialHash
+    void SetCellSize(float cellSize);
+    void SetBounds(Rectangle bounds);
+    void ClearBounds();
+    void SetMode(SpatialHashMode mode);
+    SpatialHashMode GetMode() const { return m_mode; }
+    float GetCellSize() const { return m_cellSize; }
+
+    /**
+     * Clear all entities and forget the partitions' layer/mask unions.
+     */
+    void Clear() override;
+
+    /**
+     * Insert an entity into its layer's partition.
+     * @param slot Entity's slot index in EntityComponents
+     * @param position Entity position
+     * @param radius Entity radius
+     * @param layer Entity's collision layers (LAYER_NONE = not stored)
+     * @param mask Layers the entity collides with
+     */
+    void Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+
+    /**
+     * Incremental mode: move a slot within its partition, or to another
+     * partition if the entity in it now has a different layer.
+     * Same as Insert in Rebuild mode.
+     */
+    void Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+
+    /**
+     * Incremental mode: take a slot out of its partition (no-op if absent).
+     */
+    void Remove(uint32_t slot) override;
+
+    /**
+     * Incremental mode: remove every slot >= slotCount.
+     */
+    void Truncate(uint32_t slotCount) override;
+
+    void CollectCandidatePairs(std::vector<CandidatePair>& pairs) override;
+
+    /**
+     * Visit every entity on a layer in queryMask whose cells a radius
+     * query covers, once each. Not reentrant.
+     * @param queryMask Layers to search, usually the querier's collision mask
+     * @param visit Called as visit(uint32_t slot)
+     */
+    template<typename Visitor>
+    void ForEachInRadius(Vector2 position, float radius, uint32_t queryMask, Visitor&& visit);
+
+    /**
+     * Segment query over the partitions holding a layer in layerMask; see
+     * SpatialHash::QuerySegment. accept still sees every slot of those
+     * partitions, so it should check the exact layer.
+     */
+    template<typename Accept>
+    void QuerySegment(Vector2 start, Vector2 end, const Vector2* position, const float* radius,
+                      uint32_t layerMask, Accept&& accept, bool firstHitOnly, std::vector<SegmentHit>& hits);
+
+    /**
+     * Enumerate every pair of entities that share a cell and whose
+     * partitions can interact, once.
+     * @param visit Called as visit(uint32_t slotA, uint32_t slotB)
+     */
+    template<typename Visitor>
+    void ForEachCandidatePair(Visitor&& visit);
+
+private:
+    static constexpr uint8_t NO_PARTITION = 0xFF;
+
+    struct Partition {
+        std::unique_ptr<SpatialHash> hash;  // Created on first use
+        uint32_t layers = 0;                // Union of members' layers
+        uint32_t masks = 0;                 // Union of members' masks
+        uint32_t count = 0;
+    };
+
+    SpatialHashMode m_mode;
+    float m_cellSize;
+    Rectangle m_bounds;
+    std::array<Partition, LAYER_COUNT> m_partitions;
+    std::vector<uint8_t> m_slotPartition;  // Incremental mode: partition per slot
+    std::vector<uint8_t> m_active;         // Scratch: non-empty partitions
+
+    /**
+     * @return Partition index for a layer set (its lowest bit)
+     */
+    static uint8_t PartitionOf(uint32_t layer);
+
+    SpatialHash& GetHash(uint8_t partition);
+
+    /**
+     * Pairs between two partitions, walking the cells of the smaller one.
+     */
+    template<typename Visitor>
+    void VisitCrossPairs(SpatialHash& first, SpatialHash& second, bool firstIsSmaller, Visitor& visit);
+};
+
+template<typename Visitor>
+void LayeredSpatialHash::ForEachInRadius(Vector2 position, float radius, uint32_t queryMask, Visitor&& visit)
+{
+    for (Partition& partition : m_partitions) {
+        if (partition.count > 0 && (partition.layers & queryMask) != 0) {
+            partition.hash->ForEachInRadius(position, radius, visit);
+        }
+    }
+}
+
+template<typename Accept>
+void LayeredSpatialHash::QuerySegment(Vector2 start, Vector2 end, const Vector2* position, const float* radius,
+                                      uint32_t layerMask, Accept&& accept, bool firstHitOnly,
+                                      std::vector<SegmentHit>& hits)
+{
+    const size_t firstNew = hits.size();
+
+    for (Partition& partition : m_partitions) {
+        if (partition.count == 0 || (partition.layers & layerMask) == 0) continue;
+
+        // Each partition stops at its own nearest hit; keep the nearest overall
+        const size_t before = hits.size();
+        partition.hash->QuerySegment(start, end, position, radius, accept, firstHitOnly, hits);
+        if (firstHitOnly && hits.size() > before && before > firstNew) {
+            const SegmentHit& candidate = hits.back();
+            const SegmentHit& best = hits[firstNew];
+            if (candidate.distance < best.distance ||
+                (candidate.distance == best.distance && candidate.slot < best.slot)) {
+                hits[firstNew] = candidate;
+            }
+            hits.pop_back();
+        }
+    }
+
+    if (!firstHitOnly) {
+        std::sort(hits.begin() + firstNew, hits.end(), [](const SegmentHit& a, const SegmentHit& b) {
+            return a.distance != b.distance ? a.distance < b.distance : a.slot < b.slot;
+        });
+    }
+}
+
+template<typename Visitor>
+void LayeredSpatialHash::ForEachCandidatePair(Visitor&& visit)
+{
+    m_active.clear();
+    for (uint8_t p = 0; p < LAYER_COUNT; ++p) {
+        if (m_partitions[p].count > 0) {
+            m_active.push_back(p);
+        }
+    }
+
+    for (size_t i = 0; i < m_active.size(); ++i) {
+        Partition& first = m_partitions[m_active[i]];
+        if ((first.masks & first.layers) != 0) {
+            first.hash->ForEachCandidatePair(visit);
+        }
+
+        for (size_t j = i + 1; j < m_active.size(); ++j) {
+            Partition& second = m_partitions[m_active[j]];
+            if ((first.masks & second.layers) == 0 || (second.masks & first.layers) == 0) continue;
+            VisitCrossPairs(*first.hash, *second.hash, first.count <= second.count, visit);
+        }
+    }
+}
+
+template<typename Visitor>
+void LayeredSpatialHash::VisitCrossPairs(SpatialHash& first, SpatialHash& second, bool firstIsSmaller, Visitor& visit)
+{
+    SpatialHash& walked = firstIsSmaller ? first : second;
+    SpatialHash& probed = firstIsSmaller ? second : first;
+    probed.Build();
+
+    walked.ForEachCell([&](int32_t x, int32_t y, CellSpan walkedCell) {
+        CellSpan probedCell = probed.GetCell(x, y);
+        if (probedCell.empty()) return;
+
+        for (uint32_t a : walkedCell) {
+            int32_t aX, aY;
+            walked.GetFirstCell(a, aX, aY);
+            for (uint32_t b : probedCell) {
+                // Report the pair only in the first cell both bounding boxes cover
+                int32_t bX, bY;
+                probed.GetFirstCell(b, bX, bY);
+                if ((aX > bX ? aX : bX) != x || (aY > bY ? aY : bY) != y) continue;
+
+                if (firstIsSmaller) {
+                    visit(a, b);
+                } else {
+                    visit(b, a);
+                }
+            }
+        }
+    });
+}
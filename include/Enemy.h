@@ -1,7 +1,7 @@
 #pragma once
 #include "Entity.h"
 
-class Enemy : public Entity
+class Enemy final : public Entity
 {
 public:
     // canHitOtherEnemies: if true, this enemy can be hit by other enemies' attacks
@@ -10,15 +10,25 @@ public:
     void Update(float deltaTime) override;
     void Draw() const override;
     void OnCollision(Entity* other) override;
-    void SetTarget(Vector2 target) override { m_target = target; }
 
     void TakeDamage(float damage) override;
 
     float GetHealth() const { return m_health; }
     float GetDamage() const override { return m_contactDamage; }
 
+    // Update only writes this enemy's velocity and weapon, and fire paths
+    // don't log; spawned projectiles are buffered by the manager, so the
+    // bucket can be split
+    static constexpr bool PARALLEL_UPDATE = true;
+
+    // Heads for the closest player, see EntityManager::updateEnemyTargets
+    static constexpr bool CHASES_PLAYERS = true;
+
+    // Far from its target, Update may run every few ticks with the summed
+    // time; velocity keeps it moving in between (see EntityManager::updateEntities)
+    static constexpr bool AI_LOD = true;
+
 private:
-    Vector2 m_target;
     float m_speed;
     float m_health;
     float m_maxHealth;
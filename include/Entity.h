@@ -1,8 +1,12 @@
 #pragma once
 #include "raylib.h"
 #include "CollisionSystem.h"
+#include "EntityComponents.h"
+#include "EntityHandle.h"
+#include "EntityKind.h"
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 
 // Forward declarations
 class Weapon;
@@ -10,7 +14,8 @@ class Weapon;
 class Entity
 {
 public:
-    Entity(Vector2 position, float radius,
+    // kind: EntityKindOf<ConcreteType>, see EntityKind.h
+    Entity(EntityKind kind, Vector2 position, float radius,
            uint32_t collisionLayer, uint32_t collisionMask,
            Entity* owner = nullptr);
 
@@ -22,13 +27,28 @@ public:
     // Override in derived classes to handle collision responses
     virtual void OnCollision(Entity* other) {}
 
-    // Getters
-    Vector2 GetPosition() const { return m_position; }
-    float GetRadius() const { return m_radius; }
-    bool IsAlive() const { return m_alive; }
-    uint32_t GetCollisionLayer() const { return m_collisionLayer; }
-    uint32_t GetCollisionMask() const { return m_collisionMask; }
-    Entity* GetOwner() const { return m_owner; }
+    EntityKind GetKind() const { return m_kind; }
+
+    // Getters (hot fields live in the manager's component arrays)
+    Vector2 GetPosition() const { return m_components->position[m_slot]; }
+    Vector2 GetRenderPosition() const { return m_components->Interpolated(m_slot); }  // For Draw()
+    Vector2 GetVelocity() const { return m_components->velocity[m_slot]; }
+    float GetRadius() const { return m_components->radius[m_slot]; }
+    bool IsAlive() const { return m_components->alive[m_slot] != 0; }
+    uint32_t GetCollisionLayer() const { return m_components->layer[m_slot]; }
+    uint32_t GetCollisionMask() const { return m_components->mask[m_slot]; }
+    Vector2 GetTarget() const { return m_components->target[m_slot]; }
+    EntityHandle GetHandle() const { return m_handle; }
+    EntityHandle GetOwnerHandle() const { return m_owner; }
+
+    // Resolves the owner handle; nullptr once the owner has been deleted
+    Entity* GetOwner() const;
+
+    void SetPosition(Vector2 position) { m_components->position[m_slot] = position; }
+    // Velocity is integrated by EntityManager's movement pass before Update runs
+    void SetVelocity(Vector2 velocity) { m_components->velocity[m_slot] = velocity; }
+    // For AI targeting; kinds with CHASES_PLAYERS get it from EntityManager
+    void SetTarget(Vector2 target) { m_components->target[m_slot] = target; }
 
     // Damage interface - override in entities that deal damage
     virtual float GetDamage() const { return 0.0f; }
@@ -36,15 +56,14 @@ public:
     // Damage handling - override in entities that can take damage
     virtual void TakeDamage(float damage) {}
 
-    void Kill() { m_alive = false; }
-    void SetOwner(Entity* owner) { m_owner = owner; }
+    void Kill() { m_components->Kill(m_slot); }
+    void SetOwner(Entity* owner) { m_owner = owner ? owner->GetHandle() : EntityHandle{}; }
 
     // Weapon management (optional component)
     void EquipWeapon(std::unique_ptr<Weapon> weapon);
     std::unique_ptr<Weapon> DropWeapon();
     Weapon* GetWeapon() const { return m_weapon.get(); }
     bool HasWeapon() const { return m_weapon != nullptr; }
-    virtual void SetTarget(Vector2 target) {}  // For AI targeting
 
     /**
      * Check if this entity should collide with another based on layer/mask filtering.
@@ -54,8 +73,8 @@ public:
      */
     bool ShouldCollideWith(const Entity& other) const
     {
-        return (m_collisionMask & other.m_collisionLayer) != 0 &&
-               (other.m_collisionMask & m_collisionLayer) != 0;
+        return (GetCollisionMask() & other.GetCollisionLayer()) != 0 &&
+               (other.GetCollisionMask() & GetCollisionLayer()) != 0;
     }
 
     /**
@@ -65,21 +84,49 @@ public:
      */
     bool CollidesWith(const Entity& other) const
     {
-        float dx = m_position.x - other.m_position.x;
-        float dy = m_position.y - other.m_position.y;
+        Vector2 position = GetPosition();
+        Vector2 otherPosition = other.GetPosition();
+        float dx = position.x - otherPosition.x;
+        float dy = position.y - otherPosition.y;
         float distanceSquared = dx * dx + dy * dy;
-        float radiusSum = m_radius + other.m_radius;
+        float radiusSum = GetRadius() + other.GetRadius();
         return distanceSquared < (radiusSum * radiusSum);
     }
 
 protected:
-    Vector2 m_position;
-    float m_radius;
-    bool m_alive;
-    uint32_t m_collisionLayer;  // What layer(s) this entity is on
-    uint32_t m_collisionMask;   // What layer(s) this entity collides with
-    Entity* m_owner;            // Entity that created/owns this (e.g., who shot the bullet)
+    // Row holding position/velocity/radius/layer/mask/alive. Starts in the
+    // manager's staging storage and moves to the live arrays on registration.
+    EntityComponents* m_components;
+    uint32_t m_slot;
+
+    EntityHandle m_handle;      // Issued by EntityManager on registration
+    uint32_t m_entityIndex;     // Position in EntityManager's entity list
+    uint32_t m_kindIndex;       // Position in EntityManager's per-kind list
+    EntityKind m_kind;
+    EntityHandle m_owner;       // Entity that created/owns this (e.g., who shot the bullet)
 
     // Optional weapon component (nullptr for entities that don't use weapons)
     std::unique_ptr<Weapon> m_weapon;
+
+    friend class EntityComponents;  // Re-points m_components/m_slot when rows move
+    friend class EntityManager;     // Moves rows from staging and issues handles on registration
 };
+
+/**
+ * Checked downcast using the kind tag instead of RTTI (a single compare).
+ * Registered entity types are final, so an exact tag match is a valid cast.
+ * @return entity as T*, or nullptr if it isn't a T
+ */
+template<typename T>
+T* EntityCast(Entity* entity)
+{
+    static_assert(std::is_final_v<T>, "EntityCast requires a final, registered entity type");
+    return (entity && entity->GetKind() == EntityKindOf<T>) ? static_cast<T*>(entity) : nullptr;
+}
+
+template<typename T>
+const T* EntityCast(const Entity* entity)
+{
+    static_assert(std::is_final_v<T>, "EntityCast requires a final, registered entity type");
+    return (entity && entity->GetKind() == EntityKindOf<T>) ? static_cast<const T*>(entity) : nullptr;
+}
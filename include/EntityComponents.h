@@ -0,0 +1,107 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+// Forward declaration
+class Entity;
+
+/**
+ * Structure-of-arrays storage for the entity fields touched by the hot loops
+ * (movement, enemy targeting, broad phase, narrow phase).
+ * Every entity owns exactly one row, addressed by its slot index. Rows are kept
+ * dense: releasing a slot moves the last row into the hole, so passes can walk
+ * [0, Size()) linearly without skipping holes.
+ */
+class EntityComponents {
+public:
+    std::vector<Vector2> position;
+    std::vector<Vector2> previousPosition;  // Position at the start of the current tick
+    std::vector<Vector2> velocity;
+    std::vector<float> radius;
+    std::vector<uint32_t> layer;    // What layer(s) the entity is on
+    std::vector<uint32_t> mask;     // What layer(s) the entity collides with
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> continuous;  // Swept collision; set from the kind on registration
+    std::vector<uint8_t> chasesPlayers;  // Gets a target from updateEnemyTargets; set from the kind
+    std::vector<Vector2> target;    // Point the entity is heading for (AI)
+    std::vector<float> updateDebt;  // Time an AI_LOD entity's Update hasn't covered yet
+    std::vector<Entity*> entity;    // Entity owning each row
+
+    // Entities killed since the list was last drained, in kill order
+    std::vector<Entity*> killed;
+
+    // Set by EntityManager around parallel updates: kills go to the calling
+    // thread's s_deferredKills list and are merged into `killed` at the sync point
+    bool deferKills = false;
+    static thread_local std::vector<Entity*>* s_deferredKills;
+
+    // Blend factor between previousPosition and position used when drawing
+    // (0 = last tick, 1 = current tick); set once per rendered frame
+    float renderAlpha = 1.0f;
+
+    uint32_t Size() const { return static_cast<uint32_t>(entity.size()); }
+
+    /**
+     * Clear a row's alive flag and record the death once, so cleanup only
+     * has to visit entities that actually died.
+     * @param slot Slot index to kill
+     */
+    void Kill(uint32_t slot)
+    {
+        if (alive[slot]) {
+            alive[slot] = 0;
+
+            if (deferKills && s_deferredKills) {
+                s_deferredKills->push_back(entity[slot]);
+            } else {
+                killed.push_back(entity[slot]);
+            }
+        }
+    }
+
+    /**
+     * Append a row for an entity.
+     * @return Slot index of the new row
+     */
+    uint32_t Allocate(Entity* owner, Vector2 pos, float rad,
+                      uint32_t collisionLayer, uint32_t collisionMask);
+
+    /**
+     * Release a row. The last row is moved into the freed slot and its
+     * entity is re-pointed at the new slot.
+     * @param slot Slot index to release
+     */
+    void Release(uint32_t slot);
+
+    /**
+     * Move an entity's row into another storage (e.g. staging -> live when
+     * the entity is registered). The entity is re-pointed at its new row.
+     * @param slot Slot index in this storage
+     * @param destination Storage that receives the row
+     */
+    void TransferTo(uint32_t slot, EntityComponents& destination);
+
+    /**
+     * Position to draw a row at, between the last two simulation ticks.
+     * @param slot Slot index
+     */
+    Vector2 Interpolated(uint32_t slot) const
+    {
+        Vector2 from = previousPosition[slot];
+        Vector2 to = position[slot];
+        return { from.x + (to.x - from.x) * renderAlpha,
+                 from.y + (to.y - from.y) * renderAlpha };
+    }
+
+    /**
+     * Remember every row's position as the start of a new tick.
+     */
+    void SnapshotPositions() { previousPosition = position; }
+
+    /**
+     * Movement pass: integrate velocity into position for every row.
+     * @param deltaTime Time since last frame
+     */
+    void Integrate(float deltaTime);
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Forward declaration
+class Entity;
+
+/**
+ * Weak reference to an entity: an index into the manager's handle table plus
+ * the generation the slot had when the handle was issued.
+ * Once the entity is deleted the slot's generation changes and the handle
+ * stops resolving, so holders never see a dangling pointer.
+ */
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const EntityHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * Maps handles to live entities with O(1) resolve.
+ * Freed slots are recycled through a free list with their generation bumped.
+ */
+class HandleTable {
+public:
+    /**
+     * Issue a handle for a newly registered entity.
+     * @param entity Entity the handle resolves to
+     * @return Handle to the entity
+     */
+    EntityHandle Create(Entity* entity);
+
+    /**
+     * Invalidate a handle (and every copy of it) and recycle its slot.
+     * @param handle Handle previously returned by Create
+     */
+    void Destroy(EntityHandle handle);
+
+    /**
+     * @return The entity the handle refers to, or nullptr if it was deleted
+     */
+    Entity* Resolve(EntityHandle handle) const
+    {
+        if (handle.index >= m_slots.size()) return nullptr;
+
+        const Slot& slot = m_slots[handle.index];
+        return slot.generation == handle.generation ? slot.entity : nullptr;
+    }
+
+private:
+    struct Slot {
+        Entity* entity;
+        uint32_t generation;
+        uint32_t nextFree;  // Next slot in the free list (INVALID_INDEX terminates)
+    };
+
+    std::vector<Slot> m_slots;
+    uint32_t m_freeHead = EntityHandle::INVALID_INDEX;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Forward declarations of every concrete entity type
+class Player;
+class Enemy;
+class Bullet;
+class GunBullet;
+class SwordSwing;
+class SwordSlam;
+class WeaponPickup;
+
+template<typename... Types>
+struct EntityTypeList {
+    static constexpr size_t size = sizeof...(Types);
+};
+
+/**
+ * Registry of concrete entity types.
+ * A type's kind tag is its position in this list, so tags are compile-time
+ * constants and checking an entity's type is a single integer compare.
+ * New entity types must be added here (EntityKindOf fails to compile otherwise).
+ */
+using EntityKindRegistry = EntityTypeList<
+    Player,
+    Enemy,
+    Bullet,
+    GunBullet,
+    SwordSwing,
+    SwordSlam,
+    WeaponPickup
+>;
+
+using EntityKind = uint8_t;
+
+constexpr size_t ENTITY_KIND_COUNT = EntityKindRegistry::size;
+
+namespace detail {
+    template<typename T, typename List>
+    struct EntityKindIndex;
+
+    template<typename T, typename... Rest>
+    struct EntityKindIndex<T, EntityTypeList<T, Rest...>>
+        : std::integral_constant<size_t, 0> {};
+
+    template<typename T, typename First, typename... Rest>
+    struct EntityKindIndex<T, EntityTypeList<First, Rest...>>
+        : std::integral_constant<size_t, 1 + EntityKindIndex<T, EntityTypeList<Rest...>>::value> {};
+}
+
+/**
+ * Kind tag of entity type T, e.g. EntityKindOf<GunBullet>.
+ */
+template<typename T>
+constexpr EntityKind EntityKindOf =
+    static_cast<EntityKind>(detail::EntityKindIndex<T, EntityKindRegistry>::value);
@@ -1,27 +1,141 @@
 #pragma once
-#include <queue>
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <type_traits>
 #include "Entity.h"
+#include "EntityKind.h"
+#include "EntityComponents.h"
+#include "EntityHandle.h"
 #include "CollisionSystem.h"
+#include "SweepAndPrune.h"
+#include "HierarchicalGrid.h"
+#include "FlowField.h"
+#include "JobSystem.h"
+#include "Random.h"
 
-// Forward declarations
-class Player;
-class Enemy;
+/**
+ * Read-only view over one kind's entity list that yields typed pointers.
+ * Valid until the next addWaitingEntities/deleteDeadEntities.
+ */
+template<typename T>
+class EntityView {
+public:
+    class Iterator {
+    public:
+        explicit Iterator(Entity* const* it) : m_it(it) {}
+
+        T* operator*() const { return static_cast<T*>(*m_it); }
+        Iterator& operator++() { ++m_it; return *this; }
+        bool operator!=(const Iterator& other) const { return m_it != other.m_it; }
+
+    private:
+        Entity* const* m_it;
+    };
+
+    explicit EntityView(const std::vector<Entity*>& entities) : m_entities(&entities) {}
+
+    Iterator begin() const { return Iterator(m_entities->data()); }
+    Iterator end() const { return Iterator(m_entities->data() + m_entities->size()); }
+    size_t size() const { return m_entities->size(); }
+    bool empty() const { return m_entities->empty(); }
+    T* operator[](size_t index) const { return static_cast<T*>((*m_entities)[index]); }
+
+private:
+    const std::vector<Entity*>* m_entities;
+};
+
+/**
+ * Wall-clock cost of each phase of the last step(), in milliseconds.
+ */
+struct FrameStats {
+    double targetingMs = 0.0;
+    double spawnMs = 0.0;
+    double updateMs = 0.0;
+    double collisionMs = 0.0;
+    double cleanupMs = 0.0;
+    size_t entityCount = 0;
+    size_t candidatePairs = 0;  // Pairs that passed the broad phase and layer/mask filter
+    size_t contacts = 0;        // Overlapping pairs (each notifies both sides)
+    size_t lodUpdates = 0;      // AI_LOD entities whose Update ran this tick
+    size_t lodDeferred = 0;     // AI_LOD entities left to a later tick
+
+    double TotalMs() const { return targetingMs + spawnMs + updateMs + collisionMs + cleanupMs; }
+};
+
+/**
+ * An entity touched by a raycast or segment query.
+ */
+struct RaycastHit {
+    Entity* entity;
+    float distance;  // From the segment start, in pixels
+    Vector2 point;   // Where the segment first touches the entity
+};
 
 class EntityManager {
 public:
+    EntityManager();
+
     void queueEntity(std::unique_ptr<Entity> entity);
     void deleteDeadEntities();
     void addWaitingEntities();
     void updateEntities(float deltaTime);
-    void drawEntities() const;
+    /**
+     * Draw every live entity.
+     * @param interpolation Fraction of a tick elapsed since the last step,
+     *        used to blend between the previous and current positions
+     */
+    void drawEntities(float interpolation = 1.0f);
     void checkCollisions();
+    /**
+     * Point every CHASES_PLAYERS entity at its closest live player. Runs on
+     * the component arrays: one SIMD nearest-player pass over the packed
+     * positions of the chasers due this tick. Chasers farther than
+     * TARGET_NEAR_DISTANCE from their target are due only every
+     * TARGET_REFRESH_INTERVAL ticks, staggered by slot. Also moves the flow
+     * field's sources to the live players.
+     */
+    void updateEnemyTargets();
     static EntityManager& getInstance();
 
-    // Type-safe queries (no casting needed!)
-    const std::vector<Player*>& getPlayers() const { return m_players; }
-    const std::vector<Enemy*>& getEnemies() const { return m_enemies; }
+    /**
+     * Advance the simulation one tick: enemy targeting, registration of
+     * queued entities, update, collisions and removal of the dead.
+     * Needs no window, so it also drives the headless runner.
+     * @param deltaTime Tick length in seconds
+     */
+    void step(float deltaTime);
+
+    // Per-phase timings of the last step()
+    const FrameStats& getFrameStats() const { return m_frameStats; }
+
+    // Seeded gameplay RNG; serial code only (see Random)
+    Random& getRandom() { return m_random; }
+
+    /**
+     * Nearest live entity on a layer in layerMask that the segment from
+     * start to end touches. Walks only the grid cells the segment crosses
+     * and stops at the first hit. Serial code only (not from PARALLEL_UPDATE
+     * updates); sees positions as of the first query in the current phase.
+     * @param hit Set when something is hit
+     * @return True if something is hit
+     */
+    bool raycast(Vector2 start, Vector2 end, uint32_t layerMask, RaycastHit& hit);
+
+    /**
+     * Every live entity on a layer in layerMask that the segment touches,
+     * nearest first (e.g. for piercing beams). Same rules as raycast.
+     * @param hits Cleared, then filled
+     */
+    void querySegment(Vector2 start, Vector2 end, uint32_t layerMask, std::vector<RaycastHit>& hits);
+
+    // Type-safe queries (no casting needed!), backed by the per-kind lists
+    template<typename T>
+    EntityView<T> getEntitiesOfKind() const { return EntityView<T>(m_kinds[EntityKindOf<T>].entities); }
+
+    EntityView<Player> getPlayers() const { return getEntitiesOfKind<Player>(); }
+    EntityView<Enemy> getEnemies() const { return getEntitiesOfKind<Enemy>(); }
 
     // Helper methods
     Player* getClosestPlayer(Vector2 position) const;
@@ -30,18 +144,324 @@ public:
     // Get all entities (for advanced use cases)
     const std::vector<std::unique_ptr<Entity>>& getEntities() const { return entities; }
 
+    // O(1) handle lookup; nullptr once the entity has been deleted
+    Entity* resolve(EntityHandle handle) const { return m_handles.Resolve(handle); }
+
+    // Hot per-entity fields of registered entities (dense, slot-indexed)
+    const EntityComponents& getComponents() const { return m_components; }
+
+    // Rows of entities that were created but not registered yet
+    // (the current job's buffer when called from a parallel update)
+    EntityComponents& stagingComponents() { return s_spawnBuffer ? s_spawnBuffer->staging : m_staging; }
+
+    /**
+     * Set how many threads updateEntities may use (including the caller).
+     * @param workerCount Worker count, 0 = one per hardware thread
+     */
+    void setWorkerCount(unsigned workerCount);
+    unsigned getWorkerCount() const { return m_jobs->GetWorkerCount(); }
+
+    /**
+     * The playable area: covered by the broad phase's dense grid and the flow
+     * field; players are clamped to it and bullets leaving it are culled.
+     * @param bounds World rectangle; zero width/height = unbounded (hash only,
+     *        no flow field, no clamping or culling)
+     */
+    void setWorldBounds(Rectangle bounds);
+    Rectangle getWorldBounds() const { return m_worldBounds; }
+
+    // Outside the world bounds; always false when the world is unbounded
+    bool isOutsideWorld(Vector2 position) const {
+        return m_worldBounds.width > 0.0f && m_worldBounds.height > 0.0f &&
+               (position.x < m_worldBounds.x || position.x > m_worldBounds.x + m_worldBounds.width ||
+                position.y < m_worldBounds.y || position.y > m_worldBounds.y + m_worldBounds.height);
+    }
+
+    /**
+     * Size the AI level-of-detail tiers from the visible area: AI_LOD
+     * entities within one view half-diagonal of their target update every
+     * tick, those within two every AI_LOD_MID_INTERVAL ticks, the rest
+     * every AI_LOD_FAR_INTERVAL ticks.
+     * @param width, height View size in pixels
+     */
+    void setAiLodView(float width, float height);
+    float getAiLodNearDistance() const { return m_aiLodNearDistance; }
+    float getAiLodFarDistance() const { return m_aiLodFarDistance; }
+
+    // Navigation toward the players around walls; place walls with
+    // getFlowField().SetBlocked once the world bounds are set
+    FlowField& getFlowField() { return m_flowField; }
+    const FlowField& getFlowField() const { return m_flowField; }
+
+    /**
+     * Broad-phase cell size; small cells suit the bullet-heavy population
+     * since large entities span several cells. For the hierarchical grid
+     * this is the finest level's cell size.
+     * @param cellSize Cell edge in pixels
+     */
+    void setBroadphaseCellSize(float cellSize);
+
+    // Rebuild the grids every frame, or move only entities that changed cells
+    void setBroadphaseMode(SpatialHashMode mode);
+    SpatialHashMode getBroadphaseMode() const { return m_spatialHash.GetMode(); }
+
+    /**
+     * Choose the broad-phase backend; the grid settings above only affect
+     * the two grid backends.
+     * @param type Backend used from the next checkCollisions on
+     */
+    void setBroadphase(BroadphaseType type);
+    BroadphaseType getBroadphase() const { return m_broadphaseType; }
+    const char* getBroadphaseName() const { return m_broadphase->GetName(); }
+
     template<typename Function>
     void applyOnEntities(Function function);
 
 private:
+    using BatchUpdateFn = void (*)(Entity* const* entities, size_t count, float deltaTime);
+    using StaggeredUpdateFn = void (*)(Entity* const* entities, const float* deltaTimes, size_t count);
+
+    // Entities per job when a kind's update is split across workers
+    static constexpr size_t UPDATE_CHUNK_SIZE = 256;
+
+    // Candidate pairs per narrow-phase job
+    static constexpr size_t NARROW_PHASE_CHUNK_SIZE = 2048;
+
+    // AI level of detail (AI_LOD kinds), see setAiLodView: update intervals
+    // of the mid and far tiers, and the view half-diagonals each tier reaches
+    static constexpr float AI_LOD_NEAR_VIEW_SCALE = 1.0f;
+    static constexpr float AI_LOD_FAR_VIEW_SCALE = 2.0f;
+    static constexpr uint32_t AI_LOD_MID_INTERVAL = 4;
+    static constexpr uint32_t AI_LOD_FAR_INTERVAL = 16;
+
+    // Chasers closer than this to their target re-target every tick
+    static constexpr float TARGET_NEAR_DISTANCE = 640.0f;
+    // Ticks between re-targets for the chasers farther away
+    static constexpr uint32_t TARGET_REFRESH_INTERVAL = 8;
+
+    /**
+     * All registered entities of one kind, updated by a single call.
+     */
+    struct KindList {
+        BatchUpdateFn update;
+        StaggeredUpdateFn updateStaggered;  // Per-entity time steps, for AI_LOD
+        bool parallel;    // Kind declares PARALLEL_UPDATE, see updateEntities
+        bool aiLod;       // Kind declares AI_LOD, see updateEntities
+        bool continuous;  // Kind declares CONTINUOUS_COLLISION, see checkCollisions
+        bool chasesPlayers;  // Kind declares CHASES_PLAYERS, see updateEnemyTargets
+        std::vector<Entity*> entities;
+    };
+
+    /**
+     * Side effects of one parallel update job, merged at the sync point.
+     * Buffers are per chunk (not per thread) so merging them in chunk order
+     * gives the same spawn/death order no matter which worker ran what.
+     */
+    struct SpawnBuffer {
+        EntityComponents staging;                      // Rows of entities constructed by the job
+        std::vector<std::unique_ptr<Entity>> spawns;   // queueEntity calls made by the job
+        std::vector<Entity*> kills;                    // Entities killed by the job
+    };
+
+    /**
+     * Two touching entities, a < b. time is the fraction of the tick at
+     * which swept (CONTINUOUS_COLLISION) pairs first touched; 0 otherwise.
+     */
+    struct Contact {
+        uint32_t a;
+        uint32_t b;
+        float time;
+    };
+
+    /**
+     * Output of one narrow-phase job: contacts found in its chunk of
+     * candidate pairs. Per chunk, like SpawnBuffer, so the merged list
+     * doesn't depend on the worker count.
+     */
+    struct ContactBuffer {
+        std::vector<Contact> contacts;
+        size_t candidatePairs = 0;  // Pairs that passed the layer/mask test
+    };
+
+    // Detects `static void T::UpdateBatch(Entity* const*, size_t, float)`
+    template<typename T, typename = void>
+    struct HasUpdateBatch : std::false_type {};
+    template<typename T>
+    struct HasUpdateBatch<T, std::void_t<decltype(T::UpdateBatch(
+        std::declval<Entity* const*>(), size_t{}, 0.0f))>> : std::true_type {};
+
+    // Detects `static constexpr bool T::PARALLEL_UPDATE = true`: the type's
+    // Update only writes its own state and may kill only itself
+    template<typename T, typename = void>
+    struct IsParallelUpdateSafe : std::false_type {};
+    template<typename T>
+    struct IsParallelUpdateSafe<T, std::void_t<decltype(T::PARALLEL_UPDATE)>>
+        : std::integral_constant<bool, T::PARALLEL_UPDATE> {};
+
+    // Detects `static constexpr bool T::CONTINUOUS_COLLISION = true`: the type
+    // moves far enough per tick to tunnel, so it collides along its path
+    template<typename T, typename = void>
+    struct HasContinuousCollision : std::false_type {};
+    template<typename T>
+    struct HasContinuousCollision<T, std::void_t<decltype(T::CONTINUOUS_COLLISION)>>
+        : std::integral_constant<bool, T::CONTINUOUS_COLLISION> {};
+
+    // Detects `static constexpr bool T::CHASES_PLAYERS = true`: the type heads
+    // for the closest player and reads its target from the component arrays
+    template<typename T, typename = void>
+    struct ChasesPlayers : std::false_type {};
+    template<typename T>
+    struct ChasesPlayers<T, std::void_t<decltype(T::CHASES_PLAYERS)>>
+        : std::integral_constant<bool, T::CHASES_PLAYERS> {};
+
+    // Detects `static constexpr bool T::AI_LOD = true`: the type's Update may
+    // run less often far from its target, with the time it missed
+    template<typename T, typename = void>
+    struct HasAiLod : std::false_type {};
+    template<typename T>
+    struct HasAiLod<T, std::void_t<decltype(T::AI_LOD)>>
+        : std::integral_constant<bool, T::AI_LOD> {};
+
+    template<typename T>
+    static void batchUpdate(Entity* const* bucket, size_t count, float deltaTime);
+    template<typename T>
+    static void staggeredUpdate(Entity* const* bucket, const float* deltaTimes, size_t count);
+
+    // One list per registered kind, indexed by EntityKind
+    template<typename... Types>
+    static std::array<KindList, sizeof...(Types)> makeKindLists(EntityTypeList<Types...>);
+
+    /**
+     * Run a kind's update for a list of its entities, split across workers
+     * when the kind allows it and the list is long enough.
+     * @param deltaTimes Per-entity time steps (AI_LOD kinds); nullptr = deltaTime for all
+     */
+    void updateKind(const KindList& kind, Entity* const* entities, const float* deltaTimes,
+                    size_t count, float deltaTime);
+    void updateKindParallel(const KindList& kind, Entity* const* entities, const float* deltaTimes,
+                            size_t count, float deltaTime);
+
+    /**
+     * Pick the AI_LOD entities of a kind that update this tick and the time
+     * each has to catch up on, into m_lodEntities/m_lodDeltaTimes.
+     */
+    void scheduleLodUpdates(const KindList& kind, float deltaTime);
+
+    /**
+     * Layer/mask and circle tests for candidate pairs [begin, end), in
+     * CollisionKernel batches; pairs with a CONTINUOUS_COLLISION side get
+     * the swept test instead. Reads the component arrays only, so chunks
+     * can run concurrently.
+     */
+    void findContacts(size_t begin, size_t end, ContactBuffer& buffer) const;
+
+    /**
+     * Hand every alive entity to a broad-phase structure, fast movers with
+     * their swept bounds.
+     */
+    void populateBroadphase(Broadphase& broadphase);
+
+    /**
+     * Bring m_spatialHash up to date for segment queries if it isn't.
+     */
+    void refreshQueryGrid();
+
+    // Shared part of raycast and querySegment; fills m_segmentHits
+    void findSegmentHits(Vector2 start, Vector2 end, uint32_t layerMask, bool firstHitOnly);
+    RaycastHit makeRaycastHit(Vector2 start, Vector2 end, const SegmentHit& hit) const;
+
+    // Buffer of the parallel update job running on this thread, if any
+    static thread_local SpawnBuffer* s_spawnBuffer;
+
+    // Declared first so they outlive the entities that release rows into them
+    EntityComponents m_components;
+    EntityComponents m_staging;
+    std::vector<std::unique_ptr<SpawnBuffer>> m_spawnBuffers;  // Stable addresses: entities point into them
+
     std::vector<std::unique_ptr<Entity>> entities;
 
-    // Cached typed pointers (updated automatically)
-    std::vector<Player*> m_players;
-    std::vector<Enemy*> m_enemies;
+    // Registered entities grouped by kind (replaces hand-written typed caches)
+    std::array<KindList, ENTITY_KIND_COUNT> m_kinds;
+
+    HandleTable m_handles;
+
+    // Spawns waiting for addWaitingEntities (a vector so its capacity is
+    // reused frame to frame instead of reallocating deque chunks)
+    std::vector<std::unique_ptr<Entity>> m_waiting_queue;
+
+
+    // Broad-phase backends; m_broadphase points at the active one
+    LayeredSpatialHash m_spatialHash;
+    SweepAndPrune m_sweepAndPrune;
+    HierarchicalGrid m_hierarchicalGrid;
+    Broadphase* m_broadphase;
+    BroadphaseType m_broadphaseType;
+
+    // Narrow-phase scratch, reused every frame
+    std::vector<CandidatePair> m_candidatePairs;
+    std::vector<ContactBuffer> m_contactBuffers;
+    std::vector<Contact> m_contacts;
+
+    // m_spatialHash holds the current slots and positions (segment queries
+    // rebuild it when not, e.g. after deaths or with another backend active)
+    bool m_queryGridValid = false;
+    std::vector<SegmentHit> m_segmentHits;
+
+    // Targeting scratch, reused every frame: live player positions and
+    // the slots re-targeting this tick, as packed coordinates
+    std::vector<float> m_targetPlayerX;
+    std::vector<float> m_targetPlayerY;
+    std::vector<uint32_t> m_targetSeekers;
+    std::vector<float> m_targetSeekerX;
+    std::vector<float> m_targetSeekerY;
+    std::vector<uint32_t> m_targetNearest;
+    uint32_t m_targetTick = 0;
+
+    Rectangle m_worldBounds{ 0.0f, 0.0f, 0.0f, 0.0f };
+    FlowField m_flowField;
+
+    // AI LOD scratch, reused every frame: entities due this tick and their steps
+    std::vector<Entity*> m_lodEntities;
+    std::vector<float> m_lodDeltaTimes;
+    uint32_t m_updateTick = 0;
+    float m_aiLodNearDistance = 0.0f;  // Set by setAiLodView
+    float m_aiLodFarDistance = 0.0f;
+
+    std::unique_ptr<JobSystem> m_jobs;
+    FrameStats m_frameStats;
+    Random m_random;
+};
+
+template<typename T>
+void EntityManager::staggeredUpdate(Entity* const* bucket, const float* deltaTimes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Entity* entity = bucket[i];
+        if (!entity->IsAlive()) continue;
 
-    std::queue<std::unique_ptr<Entity>> m_waiting_queue;
+        if constexpr (std::is_final_v<T>) {
+            static_cast<T*>(entity)->T::Update(deltaTimes[i]);
+        } else {
+            entity->Update(deltaTimes[i]);
+        }
+    }
+}
 
+template<typename T>
+void EntityManager::batchUpdate(Entity* const* bucket, size_t count, float deltaTime) {
+    if constexpr (HasUpdateBatch<T>::value) {
+        // Type provides its own loop over the whole bucket
+        T::UpdateBatch(bucket, count, deltaTime);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            Entity* entity = bucket[i];
+            if (!entity->IsAlive()) continue;
 
-    SpatialHash m_spatialHash;
-};
\ No newline at end of file
+            if constexpr (std::is_final_v<T>) {
+                // Exact type is known: qualified call skips the vtable and can inline
+                static_cast<T*>(entity)->T::Update(deltaTime);
+            } else {
+                entity->Update(deltaTime);
+            }
+        }
+    }
+}
\ No newline at end of file
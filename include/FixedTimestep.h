@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * Accumulator that turns variable render frame times into a whole number of
+ * fixed simulation ticks. Leftover time carries over to the next frame and is
+ * exposed as an interpolation factor for drawing.
+ */
+class FixedTimestep {
+public:
+    /**
+     * @param tickRate Simulation ticks per second (e.g. 30, 60, 120)
+     * @param maxTicksPerFrame Upper bound on ticks run for one frame, so a long
+     *                         hitch drops time instead of spiralling
+     */
+    explicit FixedTimestep(float tickRate = 60.0f, int maxTicksPerFrame = 8);
+
+    void SetTickRate(float tickRate);
+    float GetTickRate() const { return 1.0f / m_tickDuration; }
+    float GetTickDuration() const { return m_tickDuration; }
+
+    /**
+     * Add a frame's worth of time.
+     * @param frameTime Seconds since the previous frame
+     * @return Number of fixed ticks to simulate this frame
+     */
+    int Advance(float frameTime);
+
+    /**
+     * @return Fraction of a tick left in the accumulator, in [0, 1)
+     */
+    float GetAlpha() const { return m_accumulator / m_tickDuration; }
+
+private:
+    float m_tickDuration;
+    float m_accumulator;
+    int m_maxTicksPerFrame;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "raylib.h"
+
+/**
+ * Shared navigation for hordes: a grid over the world holding, for every
+ * open cell, the step distance to the nearest source (live players) and the
+ * direction of the neighbour one step closer. Chasers sample a direction
+ * in O(1) instead of each running its own path search.
+ *
+ * Distances come from a multi-source BFS over 4-connected open cells;
+ * directions may also step diagonally when both cells beside the diagonal
+ * are open, so paths don't cut wall corners. The field is only rebuilt when
+ * a source moves to another cell or walls change, at O(cells) per rebuild.
+ *
+ * Without walls the shortest path is a straight line, so the field stays
+ * inactive (no rebuilds, Sample returns zero) until a wall is placed.
+ */
+class FlowField {
+public:
+    /**
+     * @param cellSize Cell edge in pixels
+     */
+    explicit FlowField(float cellSize = 32.0f);
+
+    /**
+     * Change the cell size. Keeps the bounds; removes every wall.
+     */
+    void SetCellSize(float cellSize);
+    float GetCellSize() const { return m_cellSize; }
+
+    /**
+     * Cover a world rectangle with the grid. Removes every wall.
+     * @param bounds World area in pixels
+     */
+    void SetBounds(Rectangle bounds);
+
+    /**
+     * Drop the grid; the field stays inactive until bounds are set again.
+     */
+    void ClearBounds();
+
+    /**
+     * Mark the cells a rectangle touches as walls (or open them again).
+     * Cells outside the bounds are ignored.
+     * @param area World rectangle in pixels
+     * @param blocked True to block, false to open
+     */
+    void SetBlocked(Rectangle area, bool blocked);
+
+    /**
+     * Open every cell.
+     */
+    void ClearBlocked();
+
+    bool IsBlocked(Vector2 position) const;
+
+    // Has bounds and at least one wall; Update and Sample do nothing otherwise
+    bool IsActive() const { return m_cols > 0 && m_blockedCount > 0; }
+
+    /**
+     * Point the field at a new set of sources. Rebuilds only if the set of
+     * source cells or the walls changed since the last rebuild.
+     * @param sourceX, sourceY Packed source positions
+     * @param count Number of sources
+     * @return True if the field was rebuilt
+     */
+    bool Update(const float* sourceX, const float* sourceY, size_t count);
+
+    /**
+     * Direction to walk from a position to reach the nearest source.
+     * @return Unit vector, or {0, 0} when inactive, outside the bounds, in
+     *         a source's cell, or cut off from every source
+     */
+    Vector2 Sample(Vector2 position) const;
+
+    // Rebuilds so far (for profiling)
+    uint32_t GetRebuildCount() const { return m_rebuildCount; }
+
+private:
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFF;
+    static constexpr uint8_t NO_DIRECTION = 8;
+
+    float m_cellSize;
+    Rectangle m_bounds;
+    int32_t m_originX;  // Cell coordinates of the grid's top-left cell
+    int32_t m_originY;
+    int32_t m_cols;
+    int32_t m_rows;
+
+    std::vector<uint8_t> m_blocked;
+    uint32_t m_blockedCount;
+    std::vector<uint32_t> m_distance;   // Steps to the nearest source cell
+    std::vector<uint8_t> m_direction;   // Index into the direction table, per cell
+
+    std::vector<uint32_t> m_sourceCells;  // Sorted source cells of the last rebuild
+    std::vector<uint32_t> m_newSourceCells;
+    std::vector<uint32_t> m_queue;        // BFS frontier, reused between rebuilds
+    bool m_dirty;                         // Walls changed since the last rebuild
+    uint32_t m_rebuildCount;
+
+    /**
+     * @return Dense cell index of a position, or -1 outside the bounds
+     */
+    int64_t CellIndex(Vector2 position) const;
+
+    void Rebuild();
+};
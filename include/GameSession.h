@@ -0,0 +1,47 @@
+#pragma once
+#include "PlayerInput.h"
+#include <cstdint>
+#include <memory>
+
+// Forward declarations
+class EntityManager;
+class Weapon;
+
+/**
+ * The game's scenario: initial scene, enemy respawns and the per-tick order
+ * of input and simulation. Shared by the windowed game and the headless
+ * runner, so a recorded InputLog replays the exact same run.
+ * All randomness comes from the manager's seeded Random.
+ */
+class GameSession {
+public:
+    static constexpr float ARENA_WIDTH = 1280.0f;
+    static constexpr float ARENA_HEIGHT = 720.0f;
+
+    /**
+     * @param manager Manager to populate (expected to be empty)
+     * @param seed Seed for the manager's Random
+     */
+    GameSession(EntityManager& manager, uint64_t seed);
+
+    // Queue the player, the first enemy and the weapon pickups
+    void Start();
+
+    /**
+     * Run one fixed simulation tick.
+     * @param deltaTime Tick length in seconds
+     * @param input Controls for player 0 this tick
+     */
+    void Tick(float deltaTime, const PlayerInput& input);
+
+    uint64_t GetSeed() const { return m_seed; }
+    uint32_t GetTickIndex() const { return m_tickIndex; }
+
+private:
+    std::unique_ptr<Weapon> CreateRandomWeapon();
+
+    EntityManager& m_manager;
+    uint64_t m_seed;
+    uint32_t m_tickIndex;
+    bool m_hasActiveEnemy;
+};
@@ -1,11 +1,13 @@
 #pragma once
 #include "Entity.h"
+#include "ObjectPool.h"
+#include <cstddef>
 
 /**
  * Gun bullet projectile
  * Fast, small, straightforward damage
  */
-class GunBullet : public Entity {
+class GunBullet final : public Entity, public PooledAllocation<GunBullet> {
 public:
     GunBullet(Vector2 position, Vector2 velocity, float damage, Entity* owner);
 
@@ -15,7 +17,18 @@ public:
 
     float GetDamage() const { return m_damage; }
 
+    /**
+     * Batched update over the whole GunBullet bucket, called once per frame
+     * by EntityManager::updateEntities.
+     */
+    static void UpdateBatch(Entity* const* bullets, size_t count, float deltaTime);
+
+    // Bullets only read their own position and kill themselves
+    static constexpr bool PARALLEL_UPDATE = true;
+
+    // Fast enough to pass through an enemy between two ticks
+    static constexpr bool CONTINUOUS_COLLISION = true;
+
 private:
-    Vector2 m_velocity;
     float m_damage;
 };
@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Broadphase.h"
+#include "CollisionSystem.h"
+
+/**
+ * Multi-resolution grid: a few LayeredSpatialHash levels whose cell sizes
+ * grow by LEVEL_RATIO (16/64/256 px by default: bullets, characters, sword
+ * attacks and bosses). Each entity goes into the finest level whose cells
+ * are at least as wide as the entity, so it covers at most 2x2 cells there
+ * and no level mixes 5 px bullets with 70 px sword swings.
+ *
+ * Pairs within a level come from that level's grid. Pairs across levels
+ * are found by querying the smaller entity's bounding box in every coarser,
+ * non-empty level, restricted to the layers in its mask. Entities larger
+ * than the coarsest cells still work; they just span more cells there.
+ */
+class HierarchicalGrid : public Broadphase {
+public:
+    static constexpr uint32_t LEVEL_COUNT = 3;
+    static constexpr float LEVEL_RATIO = 4.0f;
+
+    /**
+     * @param baseCellSize Cell size of the finest level in pixels
+     */
+    explicit HierarchicalGrid(float baseCellSize = 16.0f);
+
+    const char* GetName() const override { return "hgrid"; }
+    bool IsIncremental() const override { return m_levels[0].IsIncremental(); }
+
+    // Settings apply to every level; see SpatialHash
+    void SetBaseCellSize(float baseCellSize);
+    float GetBaseCellSize() const { return m_levels[0].GetCellSize(); }
+    void SetBounds(Rectangle bounds);
+    void ClearBounds();
+    void SetMode(SpatialHashMode mode);
+
+    void Clear() override;
+    void Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+    void Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+    void Remove(uint32_t slot) override;
+    void Truncate(uint32_t slotCount) override;
+    void CollectCandidatePairs(std::vector<CandidatePair>& pairs) override;
+
+private:
+    static constexpr uint8_t NO_LEVEL = 0xFF;
+
+    // What the cross-level queries need to know about a stored slot
+    struct SlotBounds {
+        Vector2 position;
+        float radius;
+        uint32_t mask;
+    };
+
+    std::array<LayeredSpatialHash, LEVEL_COUNT> m_levels;
+    std::array<uint32_t, LEVEL_COUNT> m_levelCounts;
+    std::vector<uint8_t> m_slotLevel;
+    std::vector<SlotBounds> m_slotBounds;
+
+    /**
+     * @return Finest level whose cells fit an entity of this radius
+     */
+    uint8_t LevelFor(float radius) const;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include "PlayerInput.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Per-tick record of every player's input plus the RNG seed and tick rate a
+ * session ran with. Replaying it through GameSession reproduces the run
+ * exactly, which makes recorded play sessions usable as perf scenarios.
+ *
+ * Inputs are stored quantized (movement as int8, buttons as bits), so record
+ * through Append() and feed its return value to the simulation: that way
+ * the live run and the replay see bit-identical input.
+ * On disk, consecutive identical ticks are run-length encoded.
+ */
+class InputLog {
+public:
+    // Totals of the recorded run, stored so a replay can check itself
+    struct Summary {
+        uint32_t finalEntityCount = 0;
+        uint64_t totalCandidatePairs = 0;
+        uint64_t totalContacts = 0;
+    };
+
+    InputLog(uint64_t seed = 0, float tickRate = 60.0f, uint32_t playerCount = 1);
+
+    uint64_t GetSeed() const { return m_seed; }
+    float GetTickRate() const { return m_tickRate; }
+    uint32_t GetPlayerCount() const { return m_playerCount; }
+    uint32_t GetTickCount() const { return static_cast<uint32_t>(m_records.size() / m_playerCount); }
+
+    const Summary& GetSummary() const { return m_summary; }
+    void SetSummary(const Summary& summary) { m_summary = summary; }
+
+    /**
+     * Record the next player's input (players in order, then the next tick).
+     * @return The input as it will be replayed; apply this one, not the original
+     */
+    PlayerInput Append(const PlayerInput& input);
+
+    /**
+     * @param tick Tick index, < GetTickCount()
+     * @param player Player index, < GetPlayerCount()
+     */
+    PlayerInput Get(uint32_t tick, uint32_t player) const;
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+private:
+    struct Record {
+        int8_t moveX;
+        int8_t moveY;
+        uint8_t buttons;
+        float aimX;
+        float aimY;
+
+        bool operator==(const Record& other) const;
+    };
+
+    static Record Encode(const PlayerInput& input);
+    static PlayerInput Decode(const Record& record);
+
+    uint64_t m_seed;
+    float m_tickRate;
+    uint32_t m_playerCount;
+    Summary m_summary;
+    std::vector<Record> m_records;  // Tick-major: [tick * playerCount + player]
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Work-stealing task scheduler.
+ * Each worker owns a job queue: it pops its own work from the back (LIFO,
+ * cache-warm) and steals from the front of other workers' queues (FIFO)
+ * when it runs dry. The calling thread acts as worker 0 and helps execute
+ * jobs while it waits, so a JobSystem with N workers starts N-1 threads.
+ */
+class JobSystem {
+public:
+    /**
+     * @param workerCount Total number of workers including the calling thread
+     *                    (0 = one per hardware thread)
+     */
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_queues.size()); }
+
+    /**
+     * @return Index of the worker running the calling thread (0 for any
+     *         thread that isn't one of the pool's workers)
+     */
+    static unsigned CurrentWorker();
+
+    /**
+     * Split [0, count) into chunks of chunkSize and run them across all
+     * workers. Blocks until every chunk has finished.
+     * @param function Called as function(chunkIndex, begin, end); chunk
+     *                 boundaries depend only on count and chunkSize
+     */
+    template<typename Function>
+    void ParallelFor(size_t count, size_t chunkSize, Function&& function)
+    {
+        using FunctionType = std::remove_reference_t<Function>;
+        Dispatch(count, chunkSize, &function,
+                 [](void* context, size_t chunk, size_t begin, size_t end) {
+                     (*static_cast<FunctionType*>(context))(chunk, begin, end);
+                 });
+    }
+
+private:
+    using JobFn = void (*)(void* context, size_t chunk, size_t begin, size_t end);
+
+    struct Job {
+        JobFn run;
+        void* context;
+        size_t chunk;
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * Per-worker deque backed by a vector so its storage is reused between
+     * dispatches. The owner pops from the back; thieves take from head.
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        size_t head = 0;
+
+        void Push(const Job& job);
+        bool PopBack(Job& out);
+        bool StealFront(Job& out);
+    };
+
+    void Dispatch(size_t count, size_t chunkSize, void* context, JobFn run);
+    bool TryRunJob(unsigned worker);
+    void WorkerLoop(unsigned worker);
+
+    std::vector<WorkQueue> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<size_t> m_queued{0};    // Jobs sitting in queues
+    std::atomic<size_t> m_pending{0};   // Jobs of the current dispatch not finished yet
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Slab allocator for one entity type.
+ * Memory is carved from slabs of SlabSize objects that are never handed back
+ * to the heap; freed blocks go onto an intrusive free list and are reused by
+ * the next allocation. Once the pool has grown to the peak population,
+ * spawning and destroying objects of this type performs no heap traffic.
+ *
+ * Hook a type up by deriving it from PooledAllocation<T> (below): its
+ * class-specific operator new/delete forward to ObjectPool<T>::Instance(), so
+ * std::make_unique<T> and the unique_ptr deleter go through the pool without
+ * changing any call sites. The type must be final, so every allocation is
+ * exactly one sizeof(T) pool block and never a larger derived object.
+ *
+ * Allocation is guarded by a mutex because weapons can fire from job system
+ * workers during the parallel update; spawns are rare enough next to the
+ * update work that the lock is uncontended in practice.
+ */
+template<typename T, size_t SlabSize = 256>
+class ObjectPool {
+public:
+    /**
+     * The pool is intentionally never destroyed: entities may still be freed
+     * during static destruction (e.g. by the EntityManager singleton).
+     */
+    static ObjectPool& Instance()
+    {
+        static ObjectPool* pool = new ObjectPool();
+        return *pool;
+    }
+
+    /**
+     * Get storage for one T. Grows by a slab when the free list is empty.
+     */
+    void* Allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_freeList) {
+            AddSlab();
+        }
+
+        Block* block = m_freeList;
+        m_freeList = block->next;
+        ++m_inUse;
+        return block;
+    }
+
+    /**
+     * Return storage obtained from Allocate() to the free list.
+     */
+    void Deallocate(void* ptr)
+    {
+        if (!ptr) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Block* block = static_cast<Block*>(ptr);
+        block->next = m_freeList;
+        m_freeList = block;
+        --m_inUse;
+    }
+
+    /**
+     * Pre-allocate slabs so at least `count` objects fit without growing.
+     * @param count Number of objects to reserve storage for
+     */
+    void Reserve(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (Capacity() < count) {
+            AddSlab();
+        }
+    }
+
+    size_t Capacity() const { return m_slabs.size() * SlabSize; }
+    size_t InUse() const { return m_inUse; }
+
+private:
+    union Block {
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    ObjectPool() = default;
+
+    void AddSlab()
+    {
+        std::unique_ptr<Block[]> slab(new Block[SlabSize]);
+
+        // Thread the new blocks onto the free list
+        for (size_t i = 0; i < SlabSize; ++i) {
+            slab[i].next = m_freeList;
+            m_freeList = &slab[i];
+        }
+
+        m_slabs.push_back(std::move(slab));
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Block[]>> m_slabs;
+    Block* m_freeList = nullptr;
+    size_t m_inUse = 0;
+};
+
+/**
+ * Mixin that routes a final type's heap allocations through ObjectPool<T>:
+ *   class GunBullet final : public Entity, public PooledAllocation<GunBullet>
+ */
+template<typename T>
+class PooledAllocation {
+public:
+    static void* operator new(std::size_t)
+    {
+        static_assert(std::is_final_v<T>, "pooled types must be final");
+        return ObjectPool<T>::Instance().Allocate();
+    }
+
+    static void operator delete(void* ptr)
+    {
+        ObjectPool<T>::Instance().Deallocate(ptr);
+    }
+};
@@ -1,7 +1,8 @@
 #pragma once
 #include "Entity.h"
+#include "PlayerInput.h"
 
-class Player : public Entity
+class Player final : public Entity
 {
 public:
     // playerNumber: 0-3 for players 1-4
@@ -14,6 +15,10 @@ public:
     void HandleInput(float deltaTime);
     void Shoot(Vector2 target);
 
+    // Controls applied on the next Update (set by the game loop or a script)
+    void SetInput(const PlayerInput& input) { m_input = input; }
+    const PlayerInput& GetInput() const { return m_input; }
+
     float GetHealth() const { return m_health; }
     void TakeDamage(float damage) override;
     int GetPlayerNumber() const { return m_playerNumber; }
@@ -23,4 +28,5 @@ private:
     float m_speed;
     float m_health;
     float m_maxHealth;
+    PlayerInput m_input;
 };
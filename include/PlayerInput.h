@@ -0,0 +1,14 @@
+#pragma once
+#include "raylib.h"
+
+/**
+ * One tick of controls for a player.
+ * The simulation only ever reads this struct, so it can be filled from the
+ * keyboard/mouse (main.cpp) or from a script when running headless.
+ */
+struct PlayerInput {
+    Vector2 movement = { 0.0f, 0.0f };   // Per-axis direction in [-1, 1], normalized by Player
+    Vector2 aimTarget = { 0.0f, 0.0f };  // World position being aimed at
+    bool fire = false;                   // Fire held this tick
+    bool interact = false;               // Interact pressed this tick (pick up weapons)
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Small seeded PRNG (PCG32) for gameplay randomness.
+ * The same seed always produces the same sequence on every platform, so
+ * runs can be recorded and replayed exactly. Not thread-safe: draw from it
+ * only in serial code (spawning, setup), never inside parallel updates.
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed = 0) { Seed(seed); }
+
+    void Seed(uint64_t seed);
+    uint64_t GetSeed() const { return m_seed; }
+
+    uint32_t NextU32();
+
+    /**
+     * @return Uniform integer in [min, max] (inclusive)
+     */
+    int Range(int min, int max);
+
+    /**
+     * @return Uniform float in [min, max)
+     */
+    float Range(float min, float max);
+
+    bool Chance(float probability) { return Range(0.0f, 1.0f) < probability; }
+
+private:
+    uint64_t m_seed;
+    uint64_t m_state;
+    uint64_t m_increment;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+// Instruction set the SIMD kernels (CollisionKernel, TargetingKernel) are
+// built for, picked once from the compiler's target flags: AVX2 when the
+// build enables it, SSE2 on any other x86-64 build, scalar elsewhere.
+// Include from kernel sources only; it pulls in the intrinsics headers.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PUSH_ON_SIMD_AVX2 1
+#define PUSH_ON_SIMD_NAME "avx2"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PUSH_ON_SIMD_SSE2 1
+#define PUSH_ON_SIMD_NAME "sse2"
+#else
+#define PUSH_ON_SIMD_NAME "scalar"
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Broadphase.h"
+
+/**
+ * Sort-and-sweep broad phase along the x axis.
+ *
+ * Entities are kept in a list sorted by the left edge of their bounding
+ * box. Each frame the list is re-sorted with insertion sort, which is close
+ * to linear because entities barely move between frames (with a full sort
+ * as fallback when too many entries moved far), new entities are sorted
+ * apart and merged in, and the list is swept: an entity is only tested
+ * against the following ones whose left edge lies before its right edge.
+ * Unlike a uniform grid, cost does not blow up when many entities clump
+ * into a few cells.
+ *
+ * The sorted order survives Clear, so rebuilding every frame keeps the
+ * frame-to-frame coherence too.
+ */
+class SweepAndPrune : public Broadphase {
+public:
+    const char* GetName() const override { return "sap"; }
+    bool IsIncremental() const override { return true; }
+
+    void Clear() override;
+    void Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+    void Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask) override;
+    void Remove(uint32_t slot) override;
+    void Truncate(uint32_t slotCount) override;
+    void CollectCandidatePairs(std::vector<CandidatePair>& pairs) override;
+
+private:
+    // One entry of the sweep list; copies of the slot's data so the sweep
+    // walks a single array
+    struct Interval {
+        float minX;
+        float maxX;
+        float minY;
+        float maxY;
+        uint32_t layer;
+        uint32_t mask;
+        uint32_t slot;
+    };
+
+    // Per slot: latest bounds, and whether it is stored / already listed
+    std::vector<Interval> m_slotBounds;
+    std::vector<uint8_t> m_present;
+    std::vector<uint8_t> m_listed;
+
+    // Average shifts per kept entry before Refresh abandons insertion sort
+    static constexpr size_t INSERTION_SORT_PASSES = 4;
+
+    // Sweep list, sorted by minX as of the last CollectCandidatePairs
+    std::vector<Interval> m_intervals;
+    std::vector<Interval> m_added;   // Slots listed by this Refresh, scratch
+    std::vector<Interval> m_merged;  // Merge target, swapped with m_intervals
+
+    void EnsureSlot(uint32_t slot);
+
+    /**
+     * Drop removed slots, refresh bounds, re-sort and merge in new slots.
+     */
+    void Refresh();
+};
@@ -1,13 +1,15 @@
 #pragma once
 #include "Entity.h"
-#include <vector>
+#include "ObjectPool.h"
+#include <array>
+#include <cstddef>
 #include "raylib.h"
 
 /**
  * SwordSlam - Overhead slam attack that crashes down vertically
  * Different from horizontal swings - this is a ground pound
  */
-class SwordSlam : public Entity {
+class SwordSlam final : public Entity, public PooledAllocation<SwordSlam> {
 public:
     struct TrailPoint {
         Vector2 position;
@@ -22,7 +24,14 @@ public:
 
     float GetDamage() const override { return m_damage; }
 
+    // Follows its owner (read-only, owners update in an earlier bucket)
+    // and otherwise only touches its own state
+    static constexpr bool PARALLEL_UPDATE = true;
+
 private:
+    // A point every 15 ms living 150 ms: about 10 alive at once
+    static constexpr size_t MAX_TRAIL_POINTS = 16;
+
     float m_damage;
     float m_range;
     float m_duration;
@@ -33,12 +42,15 @@ private:
     Vector2 m_impactPoint;   // Where the sword will crash
 
     // Visual effects
-    std::vector<TrailPoint> m_trailPoints;
+    std::array<TrailPoint, MAX_TRAIL_POINTS> m_trailPoints;
+    size_t m_trailCount;
     float m_trailSpawnTimer;
     bool m_hasImpacted;
 
     // Helper methods
     float GetProgress() const;
     Vector2 GetCurrentSwordPosition() const;
+    // Sword tip for a given blade base, e.g. the interpolated render position
+    Vector2 GetCurrentSwordPosition(Vector2 position) const;
     void UpdateTrail(float deltaTime);
 };
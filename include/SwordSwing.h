@@ -1,13 +1,15 @@
 #pragma once
 #include "Entity.h"
-#include <vector>
+#include "ObjectPool.h"
+#include <array>
+#include <cstddef>
 #include "raylib.h"
 
 /**
  * SwordSwing - Temporary entity representing an active sword swing arc
  * Handles its own animation, drawing, and collision detection
  */
-class SwordSwing : public Entity {
+class SwordSwing final : public Entity, public PooledAllocation<SwordSwing> {
 public:
     struct TrailPoint {
         Vector2 position;
@@ -24,7 +26,14 @@ public:
 
     float GetDamage() const override { return m_damage; }
 
+    // Follows its owner (read-only, owners update in an earlier bucket)
+    // and otherwise only touches its own state
+    static constexpr bool PARALLEL_UPDATE = true;
+
 private:
+    // A point every 20 ms living 200 ms: about 10 alive at once
+    static constexpr size_t MAX_TRAIL_POINTS = 16;
+
     float m_damage;
     float m_range;
     float m_duration;
@@ -34,7 +43,8 @@ private:
     Color m_color;
 
     // Visual effects
-    std::vector<TrailPoint> m_trailPoints;
+    std::array<TrailPoint, MAX_TRAIL_POINTS> m_trailPoints;
+    size_t m_trailCount;
     float m_trailSpawnTimer;
 
     // Helper methods
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Batched nearest-point search for AI targeting: for every query point,
+ * the index of the closest of a small set of points (e.g. every chaser
+ * against the live players).
+ *
+ * Uses the same instruction set as CollisionKernel (see SimdIsa.h), with
+ * several queries per instruction and a scalar loop for the leftovers.
+ * Every path gives the same result as the scalar search.
+ */
+class TargetingKernel {
+public:
+    /**
+     * Nearest point to each query. Ties go to the lower point index.
+     * @param pointX, pointY Packed point coordinates
+     * @param pointCount Number of points, at least 1
+     * @param queryX, queryY Packed query coordinates
+     * @param queryCount Number of queries
+     * @param outNearest Index of the nearest point, one per query
+     */
+    static void FindNearest(const float* pointX, const float* pointY, size_t pointCount,
+                            const float* queryX, const float* queryY, size_t queryCount,
+                            uint32_t* outNearest);
+};
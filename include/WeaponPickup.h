@@ -1,6 +1,7 @@
 #pragma once
 #include "Entity.h"
 #include "Weapon.h"
+#include "EntityHandle.h"
 #include <memory>
 
 // Forward declaration
@@ -9,7 +10,7 @@ class Player;
 /**
  * WeaponPickup - Entity for weapons in the world
  */
-class WeaponPickup : public Entity {
+class WeaponPickup final : public Entity {
 public:
     WeaponPickup(Vector2 position, std::unique_ptr<Weapon> weapon);
 
@@ -24,5 +25,5 @@ private:
 
     std::unique_ptr<Weapon> m_weapon;
     float m_bobTime;  // For floating animation
-    Player* m_nearbyPlayer;  // Track nearby player for 'E' prompt
+    EntityHandle m_nearbyPlayer;  // Track nearby player for 'E' prompt
 };
@@ -0,0 +1,154 @@
+#include "CollisionKernel.h"
+#include "SimdIsa.h"
+#include <cmath>
+
+const char* CollisionKernel::GetName()
+{
+    return PUSH_ON_SIMD_NAME;
+}
+
+bool CollisionKernel::SweptTimeOfImpact(Vector2 startA, Vector2 endA, Vector2 startB, Vector2 endB,
+                                        float radiusSum, float& outTime)
+{
+    // Work in B's frame: A starts at d and moves by v, so the gap at time
+    // t is |d + v t|. Solve |d + v t|^2 = radiusSum^2 for the first root
+    const float dx = startA.x - startB.x;
+    const float dy = startA.y - startB.y;
+    const float vx = (endA.x - startA.x) - (endB.x - startB.x);
+    const float vy = (endA.y - startA.y) - (endB.y - startB.y);
+
+    const float c = dx * dx + dy * dy - radiusSum * radiusSum;
+    if (c < 0.0f) {
+        outTime = 0.0f;  // Already overlapping at the start of the tick
+        return true;
+    }
+
+    const float a = vx * vx + vy * vy;
+    const float b = dx * vx + dy * vy;  // Half of the usual linear term
+    if (a <= 0.0f || b >= 0.0f) return false;  // Not moving closer
+
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;  // Closest approach stays apart
+
+    const float time = (-b - std::sqrt(discriminant)) / a;
+    if (time > 1.0f) return false;
+
+    outTime = time;
+    return true;
+}
+
+#if defined(PUSH_ON_SIMD_AVX2)
+
+CollisionKernel::Result CollisionKernel::TestPairs(const CollisionArrays& arrays, const CandidatePair* pairs, size_t count)
+{
+    // Slot indices; a short batch repeats its first pair and masks it out
+    alignas(32) int32_t slotA[BATCH_SIZE];
+    alignas(32) int32_t slotB[BATCH_SIZE];
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        const CandidatePair& pair = pairs[i < count ? i : 0];
+        slotA[i] = static_cast<int32_t>(pair.a);
+        slotB[i] = static_cast<int32_t>(pair.b);
+    }
+    const __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(slotA));
+    const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(slotB));
+
+    // Layer/mask: (mask[a] & layer[b]) != 0 && (mask[b] & layer[a]) != 0
+    const int* layer = reinterpret_cast<const int*>(arrays.layer);
+    const int* mask = reinterpret_cast<const int*>(arrays.mask);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i rejectAB = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_i32gather_epi32(mask, a, 4),
+                                                           _mm256_i32gather_epi32(layer, b, 4)), zero);
+    __m256i rejectBA = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_i32gather_epi32(mask, b, 4),
+                                                           _mm256_i32gather_epi32(layer, a, 4)), zero);
+    uint32_t rejected = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(rejectAB, rejectBA))));
+
+    // Circles: dx^2 + dy^2 < (ra + rb)^2. Vector2 is two floats, so the
+    // x and y of slot s sit at float index 2s and 2s + 1
+    const float* x = &arrays.position->x;
+    const float* y = &arrays.position->y;
+    const __m256i a2 = _mm256_add_epi32(a, a);
+    const __m256i b2 = _mm256_add_epi32(b, b);
+    __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(x, a2, 4), _mm256_i32gather_ps(x, b2, 4));
+    __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(y, a2, 4), _mm256_i32gather_ps(y, b2, 4));
+    __m256 radiusSum = _mm256_add_ps(_mm256_i32gather_ps(arrays.radius, a, 4), _mm256_i32gather_ps(arrays.radius, b, 4));
+    __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    uint32_t overlap = static_cast<uint32_t>(_mm256_movemask_ps(
+        _mm256_cmp_ps(distanceSq, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LT_OQ)));
+
+    const uint32_t valid = (1u << count) - 1u;
+    const uint32_t filtered = ~rejected & valid;
+    return { filtered, overlap & filtered };
+}
+
+#elif defined(PUSH_ON_SIMD_SSE2)
+
+CollisionKernel::Result CollisionKernel::TestPairs(const CollisionArrays& arrays, const CandidatePair* pairs, size_t count)
+{
+    const Vector2* position = arrays.position;
+    const float* radius = arrays.radius;
+    const uint32_t* layer = arrays.layer;
+    const uint32_t* mask = arrays.mask;
+    const __m128i zero = _mm_setzero_si128();
+
+    uint32_t rejected = 0;
+    uint32_t overlap = 0;
+    for (size_t group = 0; group < BATCH_SIZE; group += 4) {
+        // No gathers before AVX2: load the group's four pairs by hand; a
+        // short batch repeats its first pair and masks it out
+        uint32_t a[4];
+        uint32_t b[4];
+        for (size_t i = 0; i < 4; ++i) {
+            const CandidatePair& pair = pairs[group + i < count ? group + i : 0];
+            a[i] = pair.a;
+            b[i] = pair.b;
+        }
+
+        __m128i maskA = _mm_setr_epi32(static_cast<int>(mask[a[0]]), static_cast<int>(mask[a[1]]),
+                                       static_cast<int>(mask[a[2]]), static_cast<int>(mask[a[3]]));
+        __m128i maskB = _mm_setr_epi32(static_cast<int>(mask[b[0]]), static_cast<int>(mask[b[1]]),
+                                       static_cast<int>(mask[b[2]]), static_cast<int>(mask[b[3]]));
+        __m128i layerA = _mm_setr_epi32(static_cast<int>(layer[a[0]]), static_cast<int>(layer[a[1]]),
+                                        static_cast<int>(layer[a[2]]), static_cast<int>(layer[a[3]]));
+        __m128i layerB = _mm_setr_epi32(static_cast<int>(layer[b[0]]), static_cast<int>(layer[b[1]]),
+                                        static_cast<int>(layer[b[2]]), static_cast<int>(layer[b[3]]));
+        __m128i reject = _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(maskA, layerB), zero),
+                                      _mm_cmpeq_epi32(_mm_and_si128(maskB, layerA), zero));
+        rejected |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(reject))) << group;
+
+        __m128 dx = _mm_sub_ps(_mm_setr_ps(position[a[0]].x, position[a[1]].x, position[a[2]].x, position[a[3]].x),
+                               _mm_setr_ps(position[b[0]].x, position[b[1]].x, position[b[2]].x, position[b[3]].x));
+        __m128 dy = _mm_sub_ps(_mm_setr_ps(position[a[0]].y, position[a[1]].y, position[a[2]].y, position[a[3]].y),
+                               _mm_setr_ps(position[b[0]].y, position[b[1]].y, position[b[2]].y, position[b[3]].y));
+        __m128 radiusSum = _mm_add_ps(_mm_setr_ps(radius[a[0]], radius[a[1]], radius[a[2]], radius[a[3]]),
+                                      _mm_setr_ps(radius[b[0]], radius[b[1]], radius[b[2]], radius[b[3]]));
+        __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        overlap |= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(distanceSq, _mm_mul_ps(radiusSum, radiusSum)))) << group;
+    }
+
+    const uint32_t valid = (1u << count) - 1u;
+    const uint32_t filtered = ~rejected & valid;
+    return { filtered, overlap & filtered };
+}
+
+#else
+
+CollisionKernel::Result CollisionKernel::TestPairs(const CollisionArrays& arrays, const CandidatePair* pairs, size_t count)
+{
+    Result result{ 0, 0 };
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t a = pairs[i].a;
+        const uint32_t b = pairs[i].b;
+        if ((arrays.mask[a] & arrays.layer[b]) == 0 || (arrays.mask[b] & arrays.layer[a]) == 0) continue;
+        result.filtered |= 1u << i;
+
+        float dx = arrays.position[a].x - arrays.position[b].x;
+        float dy = arrays.position[a].y - arrays.position[b].y;
+        float radiusSum = arrays.radius[a] + arrays.radius[b];
+        if (dx * dx + dy * dy < radiusSum * radiusSum) {
+            result.hits |= 1u << i;
+        }
+    }
+    return result;
+}
+
+#endif
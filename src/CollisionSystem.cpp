@@ -1,62 +1,327 @@
 #include "CollisionSystem.h"
-#include "Entity.h"
+#include <algorithm>
 #include <cmath>
 
 SpatialHash::SpatialHash(float cellSize)
-    : m_cellSize(cellSize)
+    : m_mode(SpatialHashMode::Rebuild)
+    , m_cellSize(cellSize)
+    , m_bounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+    , m_originX(0)
+    , m_originY(0)
+    , m_cols(0)
+    , m_rows(0)
+    , m_built(true)
+    , m_overflowCount(0)
+    , m_queryEpoch(0)
 {
 }
 
-void SpatialHash::Clear()
+void SpatialHash::SetMode(SpatialHashMode mode)
 {
+    m_mode = mode;
     m_grid.clear();
+    Clear();
+}
+
+void SpatialHash::SetCellSize(float cellSize)
+{
+    m_cellSize = cellSize;
+    if (IsBounded()) {
+        SetBounds(m_bounds);
+    } else {
+        m_grid.clear();
+        Clear();
+    }
+}
+
+void SpatialHash::SetBounds(Rectangle bounds)
+{
+    m_bounds = bounds;
+
+    int32_t maxX, maxY;
+    GetCellCoords({ bounds.x, bounds.y }, m_originX, m_originY);
+    GetCellCoords({ bounds.x + bounds.width, bounds.y + bounds.height }, maxX, maxY);
+
+    m_cols = maxX - m_originX + 1;
+    m_rows = maxY - m_originY + 1;
+    m_cellStart.assign(static_cast<size_t>(m_cols) * m_rows + 1, 0);
+    m_cellCursor.assign(static_cast<size_t>(m_cols) * m_rows, 0);
+    m_cellBuckets.assign(static_cast<size_t>(m_cols) * m_rows, {});
+    Clear();
+}
+
+void SpatialHash::ClearBounds()
+{
+    m_bounds = Rectangle{ 0.0f, 0.0f, 0.0f, 0.0f };
+    m_cols = 0;
+    m_rows = 0;
+    m_cellStart.assign(1, 0);
+    m_cellCursor.clear();
+    m_cellBuckets.clear();
+    Clear();
+}
+
+void SpatialHash::Clear()
+{
+    m_pendingSlots.clear();
+    m_pendingCells.clear();
+    m_cellEntries.clear();
+    m_overflowKeys.clear();
+    m_built = false;
+
+    if (m_mode == SpatialHashMode::Incremental) {
+        for (std::vector<uint32_t>& bucket : m_cellBuckets) {
+            bucket.clear();
+        }
+        for (CellRange& cells : m_slotCells) {
+            cells.present = false;
+        }
+    }
+
+    if (m_overflowCount > 0 || !m_grid.empty()) {
+        // Forget buckets once most of them sit empty (entities moved on),
+        // otherwise keep their storage for the next frame
+        if (m_grid.size() > 4 * m_overflowCount + 64) {
+            m_grid.clear();
+        } else {
+            for (auto& cell : m_grid) {
+                cell.second.clear();
+            }
+        }
+        m_overflowCount = 0;
+    }
+}
+
+SpatialHash::CellRange SpatialHash::ComputeCells(Vector2 position, float radius) const
+{
+    CellRange cells;
+    GetCellCoords({ position.x - radius, position.y - radius }, cells.minX, cells.minY);
+    GetCellCoords({ position.x + radius, position.y + radius }, cells.maxX, cells.maxY);
+    cells.present = true;
+    return cells;
+}
+
+void SpatialHash::EnsureSlot(uint32_t slot)
+{
+    if (slot >= m_slotCells.size()) {
+        m_slotCells.resize(slot + 1);
+        m_queryStamp.resize(slot + 1, 0);
+    }
+}
+
+void SpatialHash::Insert(uint32_t slot, Vector2 position, float radius)
+{
+    if (m_mode == SpatialHashMode::Incremental) {
+        Update(slot, position, radius);
+        return;
+    }
+
+    EnsureSlot(slot);
+    const CellRange cells = ComputeCells(position, radius);
+    m_slotCells[slot] = cells;
+
+    for (int32_t y = cells.minY; y <= cells.maxY; ++y) {
+        for (int32_t x = cells.minX; x <= cells.maxX; ++x) {
+            InsertIntoCell(slot, x, y);
+        }
+    }
+    m_built = false;
 }
 
-void SpatialHash::Insert(Entity* entity)
+void SpatialHash::Update(uint32_t slot, Vector2 position, float radius)
 {
-    if (!entity) return;
+    if (m_mode == SpatialHashMode::Rebuild) {
+        Insert(slot, position, radius);
+        return;
+    }
+
+    EnsureSlot(slot);
+    const CellRange cells = ComputeCells(position, radius);
+    if (m_slotCells[slot].present && m_slotCells[slot].SameCells(cells)) {
+        return;  // Still in the same cells: nothing to do
+    }
+
+    Remove(slot);
+    m_slotCells[slot] = cells;
+    for (int32_t y = cells.minY; y <= cells.maxY; ++y) {
+        for (int32_t x = cells.minX; x <= cells.maxX; ++x) {
+            AddToBucket(slot, x, y);
+        }
+    }
+}
 
-    int32_t cellX, cellY;
-    GetCellCoords(entity->GetPosition(), cellX, cellY);
+void SpatialHash::Remove(uint32_t slot)
+{
+    if (slot >= m_slotCells.size() || !m_slotCells[slot].present) return;
 
-    int64_t key = HashCell(cellX, cellY);
-    m_grid[key].push_back(entity);
+    CellRange& cells = m_slotCells[slot];
+    for (int32_t y = cells.minY; y <= cells.maxY; ++y) {
+        for (int32_t x = cells.minX; x <= cells.maxX; ++x) {
+            RemoveFromBucket(slot, x, y);
+        }
+    }
+    cells.present = false;
 }
 
-std::vector<Entity*> SpatialHash::QueryRadius(Vector2 position, float radius)
+void SpatialHash::Truncate(uint32_t slotCount)
 {
-    std::vector<Entity*> results;
+    for (uint32_t slot = slotCount; slot < m_slotCells.size(); ++slot) {
+        Remove(slot);
+    }
+}
 
-    int32_t centerX, centerY;
-    GetCellCoords(position, centerX, centerY);
+void SpatialHash::InsertIntoCell(uint32_t slot, int32_t x, int32_t y)
+{
+    int32_t dense = DenseCellIndex(x, y);
+    if (dense >= 0) {
+        m_pendingSlots.push_back(slot);
+        m_pendingCells.push_back(static_cast<uint32_t>(dense));
+        return;
+    }
 
-    // Calculate how many cells to check based on radius
-    int32_t cellRadius = static_cast<int32_t>(std::ceil(radius / m_cellSize));
+    int64_t key = HashCell(x, y);
+    std::vector<uint32_t>& bucket = m_grid[key];
+    if (bucket.empty()) {
+        m_overflowKeys.push_back(key);
+    }
+    bucket.push_back(slot);
+    m_overflowCount++;
+}
 
-    // Check all cells within the radius
-    for (int32_t dy = -cellRadius; dy <= cellRadius; ++dy)
-    {
-        for (int32_t dx = -cellRadius; dx <= cellRadius; ++dx)
-        {
-            int64_t key = HashCell(centerX + dx, centerY + dy);
+void SpatialHash::AddToBucket(uint32_t slot, int32_t x, int32_t y)
+{
+    int32_t dense = DenseCellIndex(x, y);
+    if (dense >= 0) {
+        m_cellBuckets[dense].push_back(slot);
+        return;
+    }
 
-            auto it = m_grid.find(key);
-            if (it != m_grid.end())
-            {
-                // Add all entities in this cell to results
-                results.insert(results.end(), it->second.begin(), it->second.end());
+    // Outside the dense grid: same fallback map as Rebuild mode
+    InsertIntoCell(slot, x, y);
+    m_built = false;  // New fallback cells need re-sorting
+}
+
+void SpatialHash::RemoveFromBucket(uint32_t slot, int32_t x, int32_t y)
+{
+    int32_t dense = DenseCellIndex(x, y);
+    std::vector<uint32_t>* bucket = nullptr;
+    int64_t key = 0;
+    auto cellIt = m_grid.end();
+    if (dense >= 0) {
+        bucket = &m_cellBuckets[dense];
+    } else {
+        key = HashCell(x, y);
+        cellIt = m_grid.find(key);
+        if (cellIt == m_grid.end()) return;
+        bucket = &cellIt->second;
+    }
+
+    // Swap-and-pop; order within a cell doesn't matter
+    auto it = std::find(bucket->begin(), bucket->end(), slot);
+    if (it == bucket->end()) return;
+    *it = bucket->back();
+    bucket->pop_back();
+
+    if (dense < 0) {
+        m_overflowCount--;
+        if (bucket->empty()) {
+            // Drop the emptied cell outright: entities roaming an unbounded
+            // world would otherwise leave a trail of empty buckets behind
+            m_grid.erase(cellIt);
+            auto keyIt = std::find(m_overflowKeys.begin(), m_overflowKeys.end(), key);
+            if (keyIt != m_overflowKeys.end()) {
+                *keyIt = m_overflowKeys.back();
+                m_overflowKeys.pop_back();
+                m_built = false;
             }
         }
     }
+}
+
+void SpatialHash::Build()
+{
+    if (m_built) return;
+    m_built = true;
+
+    // Fixed order for walking the fallback cells, independent of the map
+    std::sort(m_overflowKeys.begin(), m_overflowKeys.end());
+
+    // Incremental buckets are always up to date; only Rebuild needs the sort
+    if (!IsBounded() || m_mode == SpatialHashMode::Incremental) return;
 
+    const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+    const size_t count = m_pendingSlots.size();
+
+    // Counting sort: histogram, exclusive prefix sum, stable scatter
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0u);
+    for (size_t i = 0; i < count; ++i) {
+        m_cellStart[m_pendingCells[i] + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+
+    std::copy(m_cellStart.begin(), m_cellStart.end() - 1, m_cellCursor.begin());
+    m_cellEntries.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_cellEntries[m_cellCursor[m_pendingCells[i]]++] = m_pendingSlots[i];
+    }
+}
+
+std::vector<uint32_t> SpatialHash::QueryRadius(Vector2 position, float radius)
+{
+    std::vector<uint32_t> results;
+    QueryRadius(position, radius, results);
     return results;
 }
 
+void SpatialHash::QueryRadius(Vector2 position, float radius, std::vector<uint32_t>& results)
+{
+    results.clear();
+
+    ForEachInRadius(position, radius, [&results](uint32_t slot) {
+        results.push_back(slot);
+    });
+}
+
+uint32_t SpatialHash::BeginQuery()
+{
+    if (++m_queryEpoch == 0) {
+        // Stamp wrapped around: forget every old mark
+        std::fill(m_queryStamp.begin(), m_queryStamp.end(), 0u);
+        m_queryEpoch = 1;
+    }
+    return m_queryEpoch;
+}
+
+CellSpan SpatialHash::GetCell(int32_t x, int32_t y) const
+{
+    int32_t dense = DenseCellIndex(x, y);
+    if (dense >= 0 && m_mode == SpatialHashMode::Incremental) {
+        const std::vector<uint32_t>& bucket = m_cellBuckets[dense];
+        return { bucket.data(), bucket.data() + bucket.size() };
+    }
+    if (dense >= 0) {
+        const uint32_t* entries = m_cellEntries.data();
+        return { entries + m_cellStart[dense], entries + m_cellStart[dense + 1] };
+    }
+
+    if (m_overflowCount == 0) {
+        return {};
+    }
+
+    auto it = m_grid.find(HashCell(x, y));
+    if (it == m_grid.end()) {
+        return {};
+    }
+    return { it->second.data(), it->second.data() + it->second.size() };
+}
+
 int64_t SpatialHash::HashCell(int32_t x, int32_t y) const
 {
     // Combine x and y into a single 64-bit key
     // Upper 32 bits = x, lower 32 bits = y
-    return (static_cast<int64_t>(x) << 32) | (static_cast<int64_t>(y) & 0xFFFFFFFF);
+    return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y));
 }
 
 void SpatialHash::GetCellCoords(Vector2 pos, int32_t& outX, int32_t& outY) const
@@ -64,3 +329,159 @@ void SpatialHash::GetCellCoords(Vector2 pos, int32_t& outX, int32_t& outY) const
     outX = static_cast<int32_t>(std::floor(pos.x / m_cellSize));
     outY = static_cast<int32_t>(std::floor(pos.y / m_cellSize));
 }
+
+int32_t SpatialHash::DenseCellIndex(int32_t x, int32_t y) const
+{
+    int32_t localX = x - m_originX;
+    int32_t localY = y - m_originY;
+    if (localX < 0 || localY < 0 || localX >= m_cols || localY >= m_rows) {
+        return -1;
+    }
+    return localY * m_cols + localX;
+}
+
+LayeredSpatialHash::LayeredSpatialHash(float cellSize)
+    : m_mode(SpatialHashMode::Rebuild)
+    , m_cellSize(cellSize)
+    , m_bounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+{
+}
+
+void LayeredSpatialHash::SetCellSize(float cellSize)
+{
+    m_cellSize = cellSize;
+    for (Partition& partition : m_partitions) {
+        if (partition.hash) partition.hash->SetCellSize(cellSize);
+    }
+    Clear();
+}
+
+void LayeredSpatialHash::SetBounds(Rectangle bounds)
+{
+    m_bounds = bounds;
+    for (Partition& partition : m_partitions) {
+        if (partition.hash) partition.hash->SetBounds(bounds);
+    }
+    Clear();
+}
+
+void LayeredSpatialHash::ClearBounds()
+{
+    m_bounds = Rectangle{ 0.0f, 0.0f, 0.0f, 0.0f };
+    for (Partition& partition : m_partitions) {
+        if (partition.hash) partition.hash->ClearBounds();
+    }
+    Clear();
+}
+
+void LayeredSpatialHash::SetMode(SpatialHashMode mode)
+{
+    m_mode = mode;
+    for (Partition& partition : m_partitions) {
+        if (partition.hash) partition.hash->SetMode(mode);
+    }
+    Clear();
+}
+
+void LayeredSpatialHash::Clear()
+{
+    for (Partition& partition : m_partitions) {
+        if (partition.count > 0 || partition.layers != 0) {
+            partition.hash->Clear();
+        }
+        partition.layers = 0;
+        partition.masks = 0;
+        partition.count = 0;
+    }
+    std::fill(m_slotPartition.begin(), m_slotPartition.end(), NO_PARTITION);
+}
+
+void LayeredSpatialHash::Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    if (m_mode == SpatialHashMode::Incremental) {
+        Update(slot, position, radius, layer, mask);
+        return;
+    }
+    if (layer == LAYER_NONE) return;
+
+    const uint8_t index = PartitionOf(layer);
+    Partition& partition = m_partitions[index];
+    GetHash(index).Insert(slot, position, radius);
+    partition.layers |= layer;
+    partition.masks |= mask;
+    partition.count++;
+}
+
+void LayeredSpatialHash::Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    if (m_mode == SpatialHashMode::Rebuild) {
+        Insert(slot, position, radius, layer, mask);
+        return;
+    }
+
+    const uint8_t index = layer == LAYER_NONE ? NO_PARTITION : PartitionOf(layer);
+    if (slot >= m_slotPartition.size()) {
+        m_slotPartition.resize(slot + 1, NO_PARTITION);
+    }
+    if (m_slotPartition[slot] != index) {
+        Remove(slot);
+    }
+    if (index == NO_PARTITION) return;
+
+    Partition& partition = m_partitions[index];
+    GetHash(index).Update(slot, position, radius);
+    partition.layers |= layer;
+    partition.masks |= mask;
+    if (m_slotPartition[slot] != index) {
+        m_slotPartition[slot] = index;
+        partition.count++;
+    }
+}
+
+void LayeredSpatialHash::Remove(uint32_t slot)
+{
+    if (slot >= m_slotPartition.size() || m_slotPartition[slot] == NO_PARTITION) return;
+
+    Partition& partition = m_partitions[m_slotPartition[slot]];
+    partition.hash->Remove(slot);
+    partition.count--;
+    m_slotPartition[slot] = NO_PARTITION;
+}
+
+void LayeredSpatialHash::Truncate(uint32_t slotCount)
+{
+    for (uint32_t slot = slotCount; slot < m_slotPartition.size(); ++slot) {
+        Remove(slot);
+    }
+}
+
+void LayeredSpatialHash::CollectCandidatePairs(std::vector<CandidatePair>& pairs)
+{
+    pairs.clear();
+    ForEachCandidatePair([&pairs](uint32_t a, uint32_t b) {
+        pairs.push_back({ a, b });
+    });
+}
+
+uint8_t LayeredSpatialHash::PartitionOf(uint32_t layer)
+{
+    uint8_t index = 0;
+    while ((layer & 1u) == 0) {
+        layer >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+SpatialHash& LayeredSpatialHash::GetHash(uint8_t partition)
+{
+    std::unique_ptr<SpatialHash>& hash = m_partitions[partition].hash;
+    if (!hash) {
+        hash = std::make_unique<SpatialHash>(m_cellSize);
+        hash->SetMode(m_mode);
+        if (m_bounds.width > 0.0f && m_bounds.height > 0.0f) {
+            hash->SetBounds(m_bounds);
+        }
+    }
+    return *hash;
+}
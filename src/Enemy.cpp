@@ -1,14 +1,14 @@
 #include "Enemy.h"
 #include "Bullet.h"
+#include "EntityManager.h"
 #include "Weapon.h"
 #include <cmath>
 
 Enemy::Enemy(Vector2 position, float health, bool canHitOtherEnemies)
-    : Entity(position, 15.0f,
+    : Entity(EntityKindOf<Enemy>, position, 15.0f,
              LAYER_ENEMY,
              LAYER_PLAYER_ATTACK | LAYER_NEUTRAL_HAZARD |
              (canHitOtherEnemies ? LAYER_ENEMY_ATTACK : 0))
-    , m_target(position)
     , m_speed(120.0f)
     , m_health(health)
     , m_maxHealth(health)
@@ -18,12 +18,14 @@ Enemy::Enemy(Vector2 position, float health, bool canHitOtherEnemies)
 
 void Enemy::Update(float deltaTime)
 {
-    if (!m_alive) return;
+    if (!IsAlive()) return;
 
     // Move toward target (player)
+    Vector2 position = GetPosition();
+    Vector2 target = GetTarget();
     Vector2 direction = {
-        m_target.x - m_position.x,
-        m_target.y - m_position.y
+        target.x - position.x,
+        target.y - position.y
     };
 
     // Normalize
@@ -33,8 +35,18 @@ void Enemy::Update(float deltaTime)
         direction.x /= magnitude;
         direction.y /= magnitude;
 
-        m_position.x += direction.x * m_speed * deltaTime;
-        m_position.y += direction.y * m_speed * deltaTime;
+        // Around walls, follow the shared flow field instead of the straight line
+        Vector2 flow = EntityManager::getInstance().getFlowField().Sample(position);
+        if (flow.x != 0.0f || flow.y != 0.0f) {
+            direction = flow;
+        }
+
+        // Applied by the manager's movement pass
+        SetVelocity({ direction.x * m_speed, direction.y * m_speed });
+    }
+    else
+    {
+        SetVelocity({ 0.0f, 0.0f });
     }
 
     // Update weapon
@@ -43,22 +55,26 @@ void Enemy::Update(float deltaTime)
 
         // Attack if in range
         if (magnitude < 200.0f && m_weapon->CanFire()) {
-            m_weapon->Fire(this, m_target);
+            m_weapon->Fire(this, target);
         }
     }
 }
 
 void Enemy::Draw() const
 {
-    if (m_alive)
+    if (IsAlive())
     {
+        Vector2 position = GetRenderPosition();
+        float radius = GetRadius();
+
         // Draw enemy
-        DrawCircleV(m_position, m_radius, RED);
+        DrawCircleV(position, radius, RED);
 
         // Calculate aim direction toward target
+        Vector2 target = GetTarget();
         Vector2 aimDir = {
-            m_target.x - m_position.x,
-            m_target.y - m_position.y
+            target.x - position.x,
+            target.y - position.y
         };
         float magnitude = std::sqrt(aimDir.x * aimDir.x + aimDir.y * aimDir.y);
         if (magnitude > 0.0f) {
@@ -68,7 +84,7 @@ void Enemy::Draw() const
 
         // Draw weapon if equipped
         if (m_weapon) {
-            m_weapon->Draw(m_position, aimDir);
+            m_weapon->Draw(position, aimDir);
         }
 
         // Draw health bar
@@ -76,7 +92,7 @@ void Enemy::Draw() const
         float barHeight = 4.0f;
         float healthPercent = m_health / m_maxHealth;
 
-        Vector2 barPos = { m_position.x - barWidth / 2, m_position.y - m_radius - 10.0f };
+        Vector2 barPos = { position.x - barWidth / 2, position.y - radius - 10.0f };
         DrawRectangle(barPos.x, barPos.y, barWidth, barHeight, DARKGRAY);
         DrawRectangle(barPos.x, barPos.y, barWidth * healthPercent, barHeight, RED);
     }
@@ -93,7 +109,7 @@ void Enemy::OnCollision(Entity* other)
     // Handle collision with enemy attacks (if enabled via collision mask)
     if (other->GetCollisionLayer() & LAYER_ENEMY_ATTACK)
     {
-        if (m_collisionMask & LAYER_ENEMY_ATTACK)
+        if (GetCollisionMask() & LAYER_ENEMY_ATTACK)
         {
             TakeDamage(other->GetDamage());
         }
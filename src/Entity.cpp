@@ -1,20 +1,30 @@
 #include "Entity.h"
 #include "Weapon.h"
+#include "EntityManager.h"
 
-Entity::Entity(Vector2 position, float radius,
+Entity::Entity(EntityKind kind, Vector2 position, float radius,
                uint32_t collisionLayer, uint32_t collisionMask,
                Entity* owner)
-    : m_position(position), m_radius(radius), m_alive(true),
-      m_collisionLayer(collisionLayer), m_collisionMask(collisionMask),
-      m_owner(owner), m_weapon(nullptr) {
+    : m_components(&EntityManager::getInstance().stagingComponents()),
+      m_slot(m_components->Allocate(this, position, radius, collisionLayer, collisionMask)),
+      m_entityIndex(0),
+      m_kindIndex(0),
+      m_kind(kind),
+      m_owner(owner ? owner->GetHandle() : EntityHandle{}), m_weapon(nullptr) {
 }
 
-Entity::~Entity() = default;
+Entity::~Entity() {
+    m_components->Release(m_slot);
+}
 
 void Entity::EquipWeapon(std::unique_ptr<Weapon> weapon) {
     m_weapon = std::move(weapon);
 }
 
+Entity* Entity::GetOwner() const {
+    return EntityManager::getInstance().resolve(m_owner);
+}
+
 std::unique_ptr<Weapon> Entity::DropWeapon() {
     return std::move(m_weapon);
 }
@@ -0,0 +1,92 @@
+#include "EntityComponents.h"
+#include "Entity.h"
+
+thread_local std::vector<Entity*>* EntityComponents::s_deferredKills = nullptr;
+
+uint32_t EntityComponents::Allocate(Entity* owner, Vector2 pos, float rad,
+                                    uint32_t collisionLayer, uint32_t collisionMask)
+{
+    uint32_t slot = Size();
+
+    position.push_back(pos);
+    previousPosition.push_back(pos);
+    velocity.push_back({ 0.0f, 0.0f });
+    radius.push_back(rad);
+    layer.push_back(collisionLayer);
+    mask.push_back(collisionMask);
+    alive.push_back(1);
+    continuous.push_back(0);
+    chasesPlayers.push_back(0);
+    target.push_back(pos);
+    updateDebt.push_back(0.0f);
+    entity.push_back(owner);
+
+    return slot;
+}
+
+void EntityComponents::Release(uint32_t slot)
+{
+    uint32_t last = Size() - 1;
+
+    if (slot != last) {
+        // Move the last row into the hole and re-point its entity
+        position[slot] = position[last];
+        previousPosition[slot] = previousPosition[last];
+        velocity[slot] = velocity[last];
+        radius[slot] = radius[last];
+        layer[slot] = layer[last];
+        mask[slot] = mask[last];
+        alive[slot] = alive[last];
+        continuous[slot] = continuous[last];
+        chasesPlayers[slot] = chasesPlayers[last];
+        target[slot] = target[last];
+        updateDebt[slot] = updateDebt[last];
+        entity[slot] = entity[last];
+        entity[slot]->m_slot = slot;
+    }
+
+    position.pop_back();
+    previousPosition.pop_back();
+    velocity.pop_back();
+    radius.pop_back();
+    layer.pop_back();
+    mask.pop_back();
+    alive.pop_back();
+    continuous.pop_back();
+    chasesPlayers.pop_back();
+    target.pop_back();
+    updateDebt.pop_back();
+    entity.pop_back();
+}
+
+void EntityComponents::TransferTo(uint32_t slot, EntityComponents& destination)
+{
+    Entity* owner = entity[slot];
+
+    uint32_t newSlot = destination.Allocate(owner, position[slot], radius[slot],
+                                            layer[slot], mask[slot]);
+    destination.previousPosition[newSlot] = previousPosition[slot];
+    destination.velocity[newSlot] = velocity[slot];
+    destination.alive[newSlot] = alive[slot];
+    destination.continuous[newSlot] = continuous[slot];
+    destination.chasesPlayers[newSlot] = chasesPlayers[slot];
+    destination.target[newSlot] = target[slot];
+    destination.updateDebt[newSlot] = updateDebt[slot];
+
+    Release(slot);
+
+    owner->m_components = &destination;
+    owner->m_slot = newSlot;
+}
+
+void EntityComponents::Integrate(float deltaTime)
+{
+    const uint32_t count = Size();
+    Vector2* pos = position.data();
+    const Vector2* vel = velocity.data();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        pos[i].x += vel[i].x * deltaTime;
+        pos[i].y += vel[i].y * deltaTime;
+    }
+}
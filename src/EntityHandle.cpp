@@ -0,0 +1,35 @@
+#include "EntityHandle.h"
+
+EntityHandle HandleTable::Create(Entity* entity)
+{
+    uint32_t index;
+
+    if (m_freeHead != EntityHandle::INVALID_INDEX) {
+        // Recycle a freed slot
+        index = m_freeHead;
+        m_freeHead = m_slots[index].nextFree;
+    } else {
+        // Generations start at 1 so a default handle never matches
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back({ nullptr, 1, EntityHandle::INVALID_INDEX });
+    }
+
+    Slot& slot = m_slots[index];
+    slot.entity = entity;
+    slot.nextFree = EntityHandle::INVALID_INDEX;
+
+    return { index, slot.generation };
+}
+
+void HandleTable::Destroy(EntityHandle handle)
+{
+    if (handle.index >= m_slots.size()) return;
+
+    Slot& slot = m_slots[handle.index];
+    if (slot.generation != handle.generation) return;  // Already destroyed
+
+    slot.entity = nullptr;
+    ++slot.generation;
+    slot.nextFree = m_freeHead;
+    m_freeHead = handle.index;
+}
@@ -2,31 +2,315 @@
 #include "EntityManager.h"
 #include "Player.h"
 #include "Enemy.h"
+#include "Bullet.h"
+#include "GunBullet.h"
+#include "SwordSwing.h"
+#include "SwordSlam.h"
+#include "WeaponPickup.h"
+#include "CollisionKernel.h"
+#include "TargetingKernel.h"
 #include <memory>
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <chrono>
 
 EntityManager& EntityManager::getInstance() {
     static EntityManager manager;
     return manager;
 }
 
+thread_local EntityManager::SpawnBuffer* EntityManager::s_spawnBuffer = nullptr;
+
+template<typename... Types>
+std::array<EntityManager::KindList, sizeof...(Types)>
+EntityManager::makeKindLists(EntityTypeList<Types...>) {
+    return { KindList{ &batchUpdate<Types>, &staggeredUpdate<Types>,
+                       IsParallelUpdateSafe<Types>::value, HasAiLod<Types>::value,
+                       HasContinuousCollision<Types>::value, ChasesPlayers<Types>::value, {} }... };
+}
+
+EntityManager::EntityManager()
+    : m_kinds(makeKindLists(EntityKindRegistry{})),
+      m_broadphase(&m_spatialHash),
+      m_broadphaseType(BroadphaseType::Grid),
+      m_jobs(std::make_unique<JobSystem>()) {
+    // Default arena until the game sets its own; the broad phase keeps a
+    // dense grid over it and falls back to hashing outside
+    setWorldBounds(Rectangle{ 0.0f, 0.0f, 1280.0f, 720.0f });
+    setAiLodView(m_worldBounds.width, m_worldBounds.height);
+}
+
+void EntityManager::setWorldBounds(Rectangle bounds) {
+    m_queryGridValid = false;
+    m_worldBounds = bounds;
+    if (bounds.width > 0.0f && bounds.height > 0.0f) {
+        m_spatialHash.SetBounds(bounds);
+        m_hierarchicalGrid.SetBounds(bounds);
+        m_flowField.SetBounds(bounds);
+    } else {
+        m_spatialHash.ClearBounds();
+        m_hierarchicalGrid.ClearBounds();
+        m_flowField.ClearBounds();
+    }
+}
+
+void EntityManager::setAiLodView(float width, float height) {
+    const float halfDiagonal = 0.5f * std::sqrt(width * width + height * height);
+    m_aiLodNearDistance = AI_LOD_NEAR_VIEW_SCALE * halfDiagonal;
+    m_aiLodFarDistance = AI_LOD_FAR_VIEW_SCALE * halfDiagonal;
+}
+
+void EntityManager::setBroadphaseCellSize(float cellSize) {
+    m_queryGridValid = false;
+    m_spatialHash.SetCellSize(cellSize);
+    m_hierarchicalGrid.SetBaseCellSize(cellSize);
+}
+
+void EntityManager::setBroadphaseMode(SpatialHashMode mode) {
+    m_queryGridValid = false;
+    m_spatialHash.SetMode(mode);
+    m_hierarchicalGrid.SetMode(mode);
+}
+
+void EntityManager::setBroadphase(BroadphaseType type) {
+    m_broadphase->Clear();
+    m_queryGridValid = false;
+    m_broadphaseType = type;
+    if (type == BroadphaseType::SweepAndPrune) {
+        m_broadphase = &m_sweepAndPrune;
+    } else if (type == BroadphaseType::HierarchicalGrid) {
+        m_broadphase = &m_hierarchicalGrid;
+    } else {
+        m_broadphase = &m_spatialHash;
+    }
+}
+
+void EntityManager::setWorkerCount(unsigned workerCount) {
+    m_jobs = std::make_unique<JobSystem>(workerCount);
+}
+
 void EntityManager::queueEntity(std::unique_ptr<Entity> entity) {
     if (!entity) return;
 
-    m_waiting_queue.push(std::move(entity));
+    // Spawned from a parallel update job: defer to the sync point
+    if (s_spawnBuffer) {
+        s_spawnBuffer->spawns.push_back(std::move(entity));
+        return;
+    }
+
+    m_waiting_queue.push_back(std::move(entity));
+}
+
+namespace {
+using FrameClock = std::chrono::steady_clock;
+
+double elapsedMs(FrameClock::time_point& since) {
+    FrameClock::time_point now = FrameClock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - since).count();
+    since = now;
+    return ms;
+}
+}
+
+void EntityManager::step(float deltaTime) {
+    FrameClock::time_point mark = FrameClock::now();
+
+    updateEnemyTargets();
+    m_frameStats.targetingMs = elapsedMs(mark);
+
+    addWaitingEntities();
+    m_frameStats.spawnMs = elapsedMs(mark);
+
+    updateEntities(deltaTime);
+    m_frameStats.updateMs = elapsedMs(mark);
+
+    checkCollisions();
+    m_frameStats.collisionMs = elapsedMs(mark);
+
+    deleteDeadEntities();
+    m_frameStats.cleanupMs = elapsedMs(mark);
+
+    m_frameStats.entityCount = entities.size();
+}
+
+void EntityManager::updateEnemyTargets() {
+    // Pack the live players once
+    m_targetPlayerX.clear();
+    m_targetPlayerY.clear();
+    for (Player* player : getPlayers()) {
+        if (!player->IsAlive()) continue;
+        Vector2 position = player->GetPosition();
+        m_targetPlayerX.push_back(position.x);
+        m_targetPlayerY.push_back(position.y);
+    }
+    if (m_targetPlayerX.empty()) return;  // Chasers keep their last target and paths
+
+    // Re-path only if a player crossed into another cell (no-op without walls)
+    m_flowField.Update(m_targetPlayerX.data(), m_targetPlayerY.data(), m_targetPlayerX.size());
+
+    // Pick this tick's seekers straight from the component arrays, so no
+    // entity object is touched: chasers near their target re-pick every
+    // tick, far ones only on their turn (staggered by slot). Written without
+    // branches since which rows qualify is unpredictable
+    const uint32_t tick = m_targetTick++;
+    const float nearDistanceSq = TARGET_NEAR_DISTANCE * TARGET_NEAR_DISTANCE;
+    const uint32_t count = m_components.Size();
+    const Vector2* position = m_components.position.data();
+    const Vector2* target = m_components.target.data();
+    const uint8_t* chasesPlayers = m_components.chasesPlayers.data();
+
+    m_targetSeekers.resize(count);
+    m_targetSeekerX.resize(count);
+    m_targetSeekerY.resize(count);
+    size_t seekerCount = 0;
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const float dx = target[slot].x - position[slot].x;
+        const float dy = target[slot].y - position[slot].y;
+        const bool due = dx * dx + dy * dy < nearDistanceSq || (slot + tick) % TARGET_REFRESH_INTERVAL == 0;
+
+        m_targetSeekers[seekerCount] = slot;
+        m_targetSeekerX[seekerCount] = position[slot].x;
+        m_targetSeekerY[seekerCount] = position[slot].y;
+        seekerCount += chasesPlayers[slot] & due;
+    }
+
+    // Nearest player for all of them in one SIMD pass; ties go to the
+    // first player, as in getClosestPlayer
+    m_targetNearest.resize(seekerCount);
+    TargetingKernel::FindNearest(m_targetPlayerX.data(), m_targetPlayerY.data(), m_targetPlayerX.size(),
+                                 m_targetSeekerX.data(), m_targetSeekerY.data(), seekerCount,
+                                 m_targetNearest.data());
+
+    Vector2* targets = m_components.target.data();
+    for (size_t i = 0; i < seekerCount; ++i) {
+        const uint32_t player = m_targetNearest[i];
+        targets[m_targetSeekers[i]] = { m_targetPlayerX[player], m_targetPlayerY[player] };
+    }
 }
 
 void EntityManager::updateEntities(float deltaTime) {
-    for(auto& entity : entities) {
-        if (entity && entity->IsAlive()) {
-            entity->Update(deltaTime);
+    // Start of a new tick: draws interpolate from here
+    m_components.SnapshotPositions();
+    m_queryGridValid = false;  // Everything is about to move
+
+    // Movement pass over the dense position/velocity arrays
+    m_components.Integrate(deltaTime);
+
+    // One batch call per kind instead of one virtual call per entity.
+    // Kinds run one after another, so a job only ever races with entities
+    // of its own kind.
+    m_frameStats.lodUpdates = 0;
+    m_frameStats.lodDeferred = 0;
+    for (const KindList& kind : m_kinds) {
+        if (kind.entities.empty()) continue;
+
+        if (kind.aiLod) {
+            // Only the entities due this tick, each with the time it missed
+            scheduleLodUpdates(kind, deltaTime);
+            m_frameStats.lodUpdates += m_lodEntities.size();
+            m_frameStats.lodDeferred += kind.entities.size() - m_lodEntities.size();
+            updateKind(kind, m_lodEntities.data(), m_lodDeltaTimes.data(), m_lodEntities.size(), deltaTime);
+        } else {
+            updateKind(kind, kind.entities.data(), nullptr, kind.entities.size(), deltaTime);
         }
     }
+    ++m_updateTick;
 }
 
-void EntityManager::drawEntities() const {
+void EntityManager::scheduleLodUpdates(const KindList& kind, float deltaTime) {
+    const float nearDistanceSq = m_aiLodNearDistance * m_aiLodNearDistance;
+    const float farDistanceSq = m_aiLodFarDistance * m_aiLodFarDistance;
+    const Vector2* position = m_components.position.data();
+    const Vector2* target = m_components.target.data();
+    float* updateDebt = m_components.updateDebt.data();
+
+    m_lodEntities.clear();
+    m_lodDeltaTimes.clear();
+    for (Entity* entity : kind.entities) {
+        const uint32_t slot = entity->m_slot;
+        const float debt = updateDebt[slot] + deltaTime;
+
+        const float dx = target[slot].x - position[slot].x;
+        const float dy = target[slot].y - position[slot].y;
+        const float distanceSq = dx * dx + dy * dy;
+        const uint32_t interval = distanceSq < nearDistanceSq ? 1
+                                : distanceSq < farDistanceSq ? AI_LOD_MID_INTERVAL
+                                : AI_LOD_FAR_INTERVAL;
+
+        // Staggered by slot so each tick runs about the same share of a
+        // tier. A slot changes when rows move, so anything overdue runs too
+        const bool due = (slot + m_updateTick) % interval == 0 ||
+                         debt >= 2.0f * static_cast<float>(interval) * deltaTime;
+        if (due) {
+            m_lodEntities.push_back(entity);
+            m_lodDeltaTimes.push_back(debt);
+            updateDebt[slot] = 0.0f;
+        } else {
+            updateDebt[slot] = debt;
+        }
+    }
+}
+
+void EntityManager::updateKind(const KindList& kind, Entity* const* entities, const float* deltaTimes,
+                               size_t count, float deltaTime) {
+    if (count == 0) return;
+
+    if (kind.parallel && m_jobs->GetWorkerCount() > 1 && count > UPDATE_CHUNK_SIZE) {
+        updateKindParallel(kind, entities, deltaTimes, count, deltaTime);
+    } else if (deltaTimes) {
+        kind.updateStaggered(entities, deltaTimes, count);
+    } else {
+        kind.update(entities, count, deltaTime);
+    }
+}
+
+void EntityManager::updateKindParallel(const KindList& kind, Entity* const* entities, const float* deltaTimes,
+                                       size_t count, float deltaTime) {
+    const size_t chunkCount = (count + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+
+    while (m_spawnBuffers.size() < chunkCount) {
+        m_spawnBuffers.push_back(std::make_unique<SpawnBuffer>());
+    }
+
+    m_components.deferKills = true;
+
+    m_jobs->ParallelFor(count, UPDATE_CHUNK_SIZE,
+        [&](size_t chunk, size_t begin, size_t end) {
+            SpawnBuffer& buffer = *m_spawnBuffers[chunk];
+            s_spawnBuffer = &buffer;
+            EntityComponents::s_deferredKills = &buffer.kills;
+
+            if (deltaTimes) {
+                kind.updateStaggered(entities + begin, deltaTimes + begin, end - begin);
+            } else {
+                kind.update(entities + begin, end - begin, deltaTime);
+            }
+
+            EntityComponents::s_deferredKills = nullptr;
+            s_spawnBuffer = nullptr;
+        });
+
+    m_components.deferKills = false;
+
+    // Sync point: merge job buffers in chunk order
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        SpawnBuffer& buffer = *m_spawnBuffers[chunk];
+
+        for (auto& spawned : buffer.spawns) {
+            queueEntity(std::move(spawned));
+        }
+        buffer.spawns.clear();
+
+        m_components.killed.insert(m_components.killed.end(),
+                                   buffer.kills.begin(), buffer.kills.end());
+        buffer.kills.clear();
+    }
+}
+
+void EntityManager::drawEntities(float interpolation) {
+    m_components.renderAlpha = interpolation;
+
     for(const auto& entity : entities) {
         if (entity && entity->IsAlive()) {
             entity->Draw();
@@ -35,87 +319,271 @@ void EntityManager::drawEntities() const {
 }
 
 void EntityManager::checkCollisions() {
-    // Broad phase: Populate spatial hash with all alive entities
-    m_spatialHash.Clear();
-    for (auto& entity : entities) {
-        if (entity && entity->IsAlive()) {
-            m_spatialHash.Insert(entity.get());
+    // Read everything from the component arrays; only the collision
+    // response itself touches the Entity objects.
+    const std::vector<uint8_t>& alive = m_components.alive;
+
+    // Broad phase: hand every alive entity to the active backend. The grid
+    // then also serves segment queries until something moves
+    populateBroadphase(*m_broadphase);
+    if (m_broadphase == &m_spatialHash) {
+        m_queryGridValid = true;
+    }
+    m_broadphase->CollectCandidatePairs(m_candidatePairs);
+
+    // Narrow phase: find the contacts first, without touching any entity,
+    // split across workers when there are enough pairs
+    const size_t pairCount = m_candidatePairs.size();
+    const size_t chunkCount = pairCount == 0 ? 1 : (pairCount + NARROW_PHASE_CHUNK_SIZE - 1) / NARROW_PHASE_CHUNK_SIZE;
+    if (m_contactBuffers.size() < chunkCount) {
+        m_contactBuffers.resize(chunkCount);
+    }
+
+    if (chunkCount > 1 && m_jobs->GetWorkerCount() > 1) {
+        m_jobs->ParallelFor(pairCount, NARROW_PHASE_CHUNK_SIZE,
+            [this](size_t chunk, size_t begin, size_t end) {
+                findContacts(begin, end, m_contactBuffers[chunk]);
+            });
+    } else {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            size_t begin = chunk * NARROW_PHASE_CHUNK_SIZE;
+            findContacts(begin, std::min(begin + NARROW_PHASE_CHUNK_SIZE, pairCount), m_contactBuffers[chunk]);
         }
     }
 
-    // Narrow phase: Check collisions for each entity
-    for (auto& entity : entities) {
-        if (!entity || !entity->IsAlive()) continue;
+    // Sync point: merge the chunks in order
+    size_t candidatePairs = 0;
+    m_contacts.clear();
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const ContactBuffer& buffer = m_contactBuffers[chunk];
+        candidatePairs += buffer.candidatePairs;
+        m_contacts.insert(m_contacts.end(), buffer.contacts.begin(), buffer.contacts.end());
+    }
+
+    // Respond serially in time-of-impact, then slot order: a bullet hits
+    // the first enemy on its path, and every backend, grid mode and worker
+    // count gives the same outcome when one response kills an entity
+    // another pair involves
+    std::sort(m_contacts.begin(), m_contacts.end(), [](const Contact& x, const Contact& y) {
+        if (x.time != y.time) return x.time < y.time;
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+
+    size_t contacts = 0;
+    for (const Contact& contact : m_contacts) {
+        // Either side may have died earlier in this pass
+        if (!alive[contact.a] || !alive[contact.b]) continue;
 
-        // Query nearby entities using spatial hash
-        auto nearby = m_spatialHash.QueryRadius(
-            entity->GetPosition(),
-            entity->GetRadius() * 2.0f  // Search radius
-        );
+        ++contacts;
+        m_components.entity[contact.a]->OnCollision(m_components.entity[contact.b]);
+        m_components.entity[contact.b]->OnCollision(m_components.entity[contact.a]);
+    }
+
+    m_frameStats.candidatePairs = candidatePairs;
+    m_frameStats.contacts = contacts;
+}
 
-        // Check collisions with nearby entities
-        for (Entity* other : nearby) {
-            // Skip self-collision and dead entities
-            if (entity.get() == other || !other->IsAlive()) continue;
+void EntityManager::populateBroadphase(Broadphase& broadphase) {
+    const std::vector<Vector2>& position = m_components.position;
+    const std::vector<Vector2>& previousPosition = m_components.previousPosition;
+    const std::vector<float>& radius = m_components.radius;
+    const std::vector<uint32_t>& layer = m_components.layer;
+    const std::vector<uint32_t>& mask = m_components.mask;
+    const std::vector<uint8_t>& alive = m_components.alive;
+    const std::vector<uint8_t>& continuous = m_components.continuous;
+    const uint32_t count = m_components.Size();
 
-            // Check layer/mask filtering (fast bitwise operation)
-            if (!entity->ShouldCollideWith(*other)) continue;
+    // Fast movers cover their whole path this tick, i.e. the circle around
+    // the segment they travelled, grown by their radius
+    auto bounds = [&](uint32_t i, Vector2& center, float& extent) {
+        center = position[i];
+        extent = radius[i];
+        if (continuous[i]) {
+            Vector2 from = previousPosition[i];
+            float dx = center.x - from.x;
+            float dy = center.y - from.y;
+            center = { from.x + dx * 0.5f, from.y + dy * 0.5f };
+            extent += 0.5f * std::sqrt(dx * dx + dy * dy);
+        }
+    };
 
-            // Actual collision detection (narrow phase)
-            if (entity->CollidesWith(*other)) {
-                // Notify both entities of the collision
-                entity->OnCollision(other);
-                // Note: We don't call other->OnCollision(entity.get()) here
-                // because it will be handled when 'other' is processed in the outer loop
+    Vector2 center;
+    float extent;
+    if (broadphase.IsIncremental()) {
+        // The backend only does work for entities that moved (or whose
+        // slot now holds a different entity)
+        for (uint32_t i = 0; i < count; ++i) {
+            if (alive[i]) {
+                bounds(i, center, extent);
+                broadphase.Update(i, center, extent, layer[i], mask[i]);
+            } else {
+                broadphase.Remove(i);
+            }
+        }
+        broadphase.Truncate(count);
+    } else {
+        broadphase.Clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (alive[i]) {
+                bounds(i, center, extent);
+                broadphase.Insert(i, center, extent, layer[i], mask[i]);
+            }
+        }
+    }
+}
+
+void EntityManager::refreshQueryGrid() {
+    if (m_queryGridValid) return;
+    populateBroadphase(m_spatialHash);
+    m_queryGridValid = true;
+}
+
+void EntityManager::findSegmentHits(Vector2 start, Vector2 end, uint32_t layerMask, bool firstHitOnly) {
+    refreshQueryGrid();
+
+    const uint8_t* alive = m_components.alive.data();
+    const uint32_t* layer = m_components.layer.data();
+    m_segmentHits.clear();
+    m_spatialHash.QuerySegment(start, end, m_components.position.data(), m_components.radius.data(),
+                               layerMask,
+                               [alive, layer, layerMask](uint32_t slot) {
+                                   return alive[slot] && (layer[slot] & layerMask) != 0;
+                               },
+                               firstHitOnly, m_segmentHits);
+}
+
+RaycastHit EntityManager::makeRaycastHit(Vector2 start, Vector2 end, const SegmentHit& hit) const {
+    float dx = end.x - start.x;
+    float dy = end.y - start.y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    float fraction = length > 0.0f ? hit.distance / length : 0.0f;
+    return { m_components.entity[hit.slot], hit.distance,
+             { start.x + dx * fraction, start.y + dy * fraction } };
+}
+
+bool EntityManager::raycast(Vector2 start, Vector2 end, uint32_t layerMask, RaycastHit& hit) {
+    findSegmentHits(start, end, layerMask, true);
+    if (m_segmentHits.empty()) return false;
+
+    hit = makeRaycastHit(start, end, m_segmentHits.front());
+    return true;
+}
+
+void EntityManager::querySegment(Vector2 start, Vector2 end, uint32_t layerMask, std::vector<RaycastHit>& hits) {
+    findSegmentHits(start, end, layerMask, false);
+
+    hits.clear();
+    for (const SegmentHit& segmentHit : m_segmentHits) {
+        hits.push_back(makeRaycastHit(start, end, segmentHit));
+    }
+}
+
+void EntityManager::findContacts(size_t begin, size_t end, ContactBuffer& buffer) const {
+    const CollisionArrays arrays{ m_components.position.data(), m_components.radius.data(),
+                                  m_components.layer.data(), m_components.mask.data() };
+    const Vector2* previousPosition = m_components.previousPosition.data();
+    const uint8_t* continuous = m_components.continuous.data();
+
+    buffer.contacts.clear();
+    buffer.candidatePairs = 0;
+    for (size_t batch = begin; batch < end; batch += CollisionKernel::BATCH_SIZE) {
+        const size_t count = std::min(CollisionKernel::BATCH_SIZE, end - batch);
+        const CandidatePair* pairs = m_candidatePairs.data() + batch;
+
+        // Layer/mask filter and circle test for the whole batch at once
+        const CollisionKernel::Result result = CollisionKernel::TestPairs(arrays, pairs, count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t bit = 1u << i;
+            if ((result.filtered & bit) == 0) continue;
+            ++buffer.candidatePairs;
+
+            const uint32_t a = std::min(pairs[i].a, pairs[i].b);
+            const uint32_t b = std::max(pairs[i].a, pairs[i].b);
+            if (continuous[a] || continuous[b]) {
+                // Fast mover: test the whole path, not just where it ended up.
+                // A side without CONTINUOUS_COLLISION is taken to stand at its
+                // end position, which is all the broad phase covered for it
+                const Vector2 startA = continuous[a] ? previousPosition[a] : arrays.position[a];
+                const Vector2 startB = continuous[b] ? previousPosition[b] : arrays.position[b];
+                float time = 1.0f;
+                bool touched = CollisionKernel::SweptTimeOfImpact(startA, arrays.position[a],
+                                                                  startB, arrays.position[b],
+                                                                  arrays.radius[a] + arrays.radius[b], time);
+                if (touched || (result.hits & bit)) {
+                    buffer.contacts.push_back({ a, b, time });
+                }
+            } else if (result.hits & bit) {
+                buffer.contacts.push_back({ a, b, 0.0f });
             }
         }
     }
 }
 
 void EntityManager::deleteDeadEntities() {
-    // Remove dead entities from main vector
-    entities.erase(
-        std::remove_if(entities.begin(), entities.end(),
-            [](const std::unique_ptr<Entity>& entity) {
-                return !entity || !entity->IsAlive();
-            }),
-        entities.end()
-    );
-
-    // Clean up cached pointers
-    m_players.erase(
-        std::remove_if(m_players.begin(), m_players.end(),
-            [](Player* player) {
-                return !player || !player->IsAlive();
-            }),
-        m_players.end()
-    );
-
-    m_enemies.erase(
-        std::remove_if(m_enemies.begin(), m_enemies.end(),
-            [](Enemy* enemy) {
-                return !enemy || !enemy->IsAlive();
-            }),
-        m_enemies.end()
-    );
+    // Only visit entities that died this frame; every list is updated with
+    // swap-and-pop, so cost scales with deaths rather than live entities
+    for (Entity* dead : m_components.killed) {
+        // Per-kind list
+        std::vector<Entity*>& kindList = m_kinds[dead->GetKind()].entities;
+        Entity* lastOfKind = kindList.back();
+        kindList[dead->m_kindIndex] = lastOfKind;
+        lastOfKind->m_kindIndex = dead->m_kindIndex;
+        kindList.pop_back();
+
+        // Invalidate handles so references held by other entities stop resolving
+        m_handles.Destroy(dead->GetHandle());
+
+        // Owning list
+        uint32_t index = dead->m_entityIndex;
+        std::unique_ptr<Entity> owned = std::move(entities[index]);
+        if (index != entities.size() - 1) {
+            entities[index] = std::move(entities.back());
+            entities[index]->m_entityIndex = index;
+        }
+        entities.pop_back();
+
+        // owned is destroyed here, releasing its component row
+    }
+
+    m_components.killed.clear();
+    m_queryGridValid = false;  // Released rows moved other entities' slots
 }
 
 void EntityManager::addWaitingEntities() {
-    while(!m_waiting_queue.empty()) {
-        std::unique_ptr<Entity> entity = std::move(m_waiting_queue.front());
-        m_waiting_queue.pop();
+    for (auto& waiting : m_waiting_queue) {
+        std::unique_ptr<Entity> entity = std::move(waiting);
 
-        // Cache typed pointers for fast, type-safe queries
         Entity* rawPtr = entity.get();
 
-        if (auto* player = dynamic_cast<Player*>(rawPtr)) {
-            m_players.push_back(player);
-        }
-        else if (auto* enemy = dynamic_cast<Enemy*>(rawPtr)) {
-            m_enemies.push_back(enemy);
-        }
+        // Move the entity's hot fields from staging into the live arrays
+        rawPtr->m_components->TransferTo(rawPtr->m_slot, m_components);
+        rawPtr->m_handle = m_handles.Create(rawPtr);
 
+        KindList& kind = m_kinds[rawPtr->GetKind()];
+        m_components.continuous[rawPtr->m_slot] = kind.continuous;
+        m_components.chasesPlayers[rawPtr->m_slot] = kind.chasesPlayers;
+
+        // Per-kind list doubles as the typed cache (no RTTI needed)
+        std::vector<Entity*>& kindList = kind.entities;
+        rawPtr->m_kindIndex = static_cast<uint32_t>(kindList.size());
+        kindList.push_back(rawPtr);
+
+        rawPtr->m_entityIndex = static_cast<uint32_t>(entities.size());
         entities.push_back(std::move(entity));
+
+        // Killed before registration: hand the death over to the live arrays
+        if (!rawPtr->IsAlive()) {
+            m_components.killed.push_back(rawPtr);
+        }
+    }
+
+    m_waiting_queue.clear();
+    m_queryGridValid = false;  // New slots
+
+    // Every queued row has moved out of staging, so its deaths are accounted for
+    m_staging.killed.clear();
+    for (auto& buffer : m_spawnBuffers) {
+        buffer->staging.killed.clear();
     }
 };
 
@@ -123,7 +591,7 @@ Player* EntityManager::getClosestPlayer(Vector2 position) const {
     Player* closest = nullptr;
     float minDistSq = std::numeric_limits<float>::max();
 
-    for (Player* player : m_players) {
+    for (Player* player : getPlayers()) {
         if (!player || !player->IsAlive()) continue;
 
         Vector2 playerPos = player->GetPosition();
@@ -143,7 +611,7 @@ Player* EntityManager::getClosestPlayer(Vector2 position) const {
 Player* EntityManager::getPlayer(int playerNumber) const {
     uint32_t targetLayer = 1 << playerNumber;  // LAYER_PLAYER_1, LAYER_PLAYER_2, etc.
 
-    for (Player* player : m_players) {
+    for (Player* player : getPlayers()) {
         if (player && player->IsAlive() &&
             (player->GetCollisionLayer() & targetLayer)) {
             return player;
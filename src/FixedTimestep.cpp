@@ -0,0 +1,33 @@
+#include "FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(float tickRate, int maxTicksPerFrame)
+    : m_tickDuration(1.0f / tickRate)
+    , m_accumulator(0.0f)
+    , m_maxTicksPerFrame(maxTicksPerFrame)
+{
+}
+
+void FixedTimestep::SetTickRate(float tickRate)
+{
+    // Keep the same fraction of a tick pending so interpolation doesn't jump
+    float alpha = GetAlpha();
+    m_tickDuration = 1.0f / tickRate;
+    m_accumulator = alpha * m_tickDuration;
+}
+
+int FixedTimestep::Advance(float frameTime)
+{
+    m_accumulator += frameTime;
+
+    int ticks = static_cast<int>(m_accumulator / m_tickDuration);
+    if (ticks > m_maxTicksPerFrame) {
+        // Too far behind: run what we can and forget the rest
+        ticks = m_maxTicksPerFrame;
+        m_accumulator = 0.0f;
+        return ticks;
+    }
+
+    m_accumulator -= ticks * m_tickDuration;
+    if (m_accumulator < 0.0f) m_accumulator = 0.0f;
+    return ticks;
+}
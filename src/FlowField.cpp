@@ -0,0 +1,204 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Neighbour offsets: the four sides first, then the diagonals
+constexpr int32_t NEIGHBOUR_DX[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+constexpr int32_t NEIGHBOUR_DY[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+constexpr float DIAGONAL = 0.70710678f;
+constexpr Vector2 DIRECTIONS[8] = {
+    { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+    { DIAGONAL, DIAGONAL }, { -DIAGONAL, DIAGONAL }, { DIAGONAL, -DIAGONAL }, { -DIAGONAL, -DIAGONAL }
+};
+}
+
+FlowField::FlowField(float cellSize)
+    : m_cellSize(cellSize)
+    , m_bounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+    , m_originX(0)
+    , m_originY(0)
+    , m_cols(0)
+    , m_rows(0)
+    , m_blockedCount(0)
+    , m_dirty(true)
+    , m_rebuildCount(0)
+{
+}
+
+void FlowField::SetCellSize(float cellSize)
+{
+    m_cellSize = cellSize;
+    if (m_cols > 0) {
+        SetBounds(m_bounds);
+    }
+}
+
+void FlowField::SetBounds(Rectangle bounds)
+{
+    m_bounds = bounds;
+    m_originX = static_cast<int32_t>(std::floor(bounds.x / m_cellSize));
+    m_originY = static_cast<int32_t>(std::floor(bounds.y / m_cellSize));
+    m_cols = static_cast<int32_t>(std::floor((bounds.x + bounds.width) / m_cellSize)) - m_originX + 1;
+    m_rows = static_cast<int32_t>(std::floor((bounds.y + bounds.height) / m_cellSize)) - m_originY + 1;
+
+    const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+    m_blocked.assign(cellCount, 0);
+    m_blockedCount = 0;
+    m_distance.assign(cellCount, UNREACHABLE);
+    m_direction.assign(cellCount, NO_DIRECTION);
+    m_sourceCells.clear();
+    m_dirty = true;
+}
+
+void FlowField::ClearBounds()
+{
+    m_bounds = Rectangle{ 0.0f, 0.0f, 0.0f, 0.0f };
+    m_cols = 0;
+    m_rows = 0;
+    m_blocked.clear();
+    m_blockedCount = 0;
+    m_distance.clear();
+    m_direction.clear();
+    m_sourceCells.clear();
+    m_dirty = true;
+}
+
+void FlowField::SetBlocked(Rectangle area, bool blocked)
+{
+    if (m_cols == 0) return;
+
+    const int32_t minX = std::max(static_cast<int32_t>(std::floor(area.x / m_cellSize)) - m_originX, 0);
+    const int32_t minY = std::max(static_cast<int32_t>(std::floor(area.y / m_cellSize)) - m_originY, 0);
+    const int32_t maxX = std::min(static_cast<int32_t>(std::floor((area.x + area.width) / m_cellSize)) - m_originX, m_cols - 1);
+    const int32_t maxY = std::min(static_cast<int32_t>(std::floor((area.y + area.height) / m_cellSize)) - m_originY, m_rows - 1);
+
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            uint8_t& cell = m_blocked[static_cast<size_t>(y) * m_cols + x];
+            if (cell != static_cast<uint8_t>(blocked)) {
+                cell = blocked;
+                if (blocked) {
+                    ++m_blockedCount;
+                } else {
+                    --m_blockedCount;
+                }
+                m_dirty = true;
+            }
+        }
+    }
+}
+
+void FlowField::ClearBlocked()
+{
+    std::fill(m_blocked.begin(), m_blocked.end(), 0);
+    m_blockedCount = 0;
+    m_dirty = true;
+}
+
+bool FlowField::IsBlocked(Vector2 position) const
+{
+    const int64_t cell = CellIndex(position);
+    return cell >= 0 && m_blocked[cell] != 0;
+}
+
+int64_t FlowField::CellIndex(Vector2 position) const
+{
+    const int32_t x = static_cast<int32_t>(std::floor(position.x / m_cellSize)) - m_originX;
+    const int32_t y = static_cast<int32_t>(std::floor(position.y / m_cellSize)) - m_originY;
+    if (x < 0 || y < 0 || x >= m_cols || y >= m_rows) return -1;
+    return static_cast<int64_t>(y) * m_cols + x;
+}
+
+bool FlowField::Update(const float* sourceX, const float* sourceY, size_t count)
+{
+    if (!IsActive()) return false;
+
+    m_newSourceCells.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t cell = CellIndex({ sourceX[i], sourceY[i] });
+        if (cell >= 0) {
+            m_newSourceCells.push_back(static_cast<uint32_t>(cell));
+        }
+    }
+    std::sort(m_newSourceCells.begin(), m_newSourceCells.end());
+    m_newSourceCells.erase(std::unique(m_newSourceCells.begin(), m_newSourceCells.end()), m_newSourceCells.end());
+
+    // Sources still in the same cells over the same walls: nothing to redo
+    if (!m_dirty && m_newSourceCells == m_sourceCells) return false;
+
+    m_sourceCells.swap(m_newSourceCells);
+    Rebuild();
+    return true;
+}
+
+void FlowField::Rebuild()
+{
+    m_dirty = false;
+    ++m_rebuildCount;
+    std::fill(m_distance.begin(), m_distance.end(), UNREACHABLE);
+    std::fill(m_direction.begin(), m_direction.end(), NO_DIRECTION);
+
+    // Multi-source BFS: every source cell starts at distance 0. A source
+    // standing in a wall cell still seeds it, so chasers can reach it
+    m_queue.clear();
+    for (uint32_t cell : m_sourceCells) {
+        m_distance[cell] = 0;
+        m_queue.push_back(cell);
+    }
+    for (size_t head = 0; head < m_queue.size(); ++head) {
+        const uint32_t cell = m_queue[head];
+        const int32_t x = static_cast<int32_t>(cell % m_cols);
+        const int32_t y = static_cast<int32_t>(cell / m_cols);
+        const uint32_t nextDistance = m_distance[cell] + 1;
+
+        for (int n = 0; n < 4; ++n) {
+            const int32_t nx = x + NEIGHBOUR_DX[n];
+            const int32_t ny = y + NEIGHBOUR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= m_cols || ny >= m_rows) continue;
+
+            const uint32_t neighbour = static_cast<uint32_t>(ny * m_cols + nx);
+            if (m_blocked[neighbour] || m_distance[neighbour] != UNREACHABLE) continue;
+            m_distance[neighbour] = nextDistance;
+            m_queue.push_back(neighbour);
+        }
+    }
+
+    // Each reached cell points at its closest neighbour; diagonals only
+    // when both cells beside them are open
+    for (uint32_t cell : m_queue) {
+        const uint32_t distance = m_distance[cell];
+        if (distance == 0) continue;
+
+        const int32_t x = static_cast<int32_t>(cell % m_cols);
+        const int32_t y = static_cast<int32_t>(cell / m_cols);
+        uint32_t bestDistance = distance;
+        uint8_t best = NO_DIRECTION;
+        for (uint8_t n = 0; n < 8; ++n) {
+            const int32_t nx = x + NEIGHBOUR_DX[n];
+            const int32_t ny = y + NEIGHBOUR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= m_cols || ny >= m_rows) continue;
+            if (n >= 4 && (m_blocked[static_cast<size_t>(y) * m_cols + nx] ||
+                           m_blocked[static_cast<size_t>(ny) * m_cols + x])) {
+                continue;
+            }
+
+            const uint32_t neighbourDistance = m_distance[static_cast<size_t>(ny) * m_cols + nx];
+            if (neighbourDistance < bestDistance) {
+                bestDistance = neighbourDistance;
+                best = n;
+            }
+        }
+        m_direction[cell] = best;
+    }
+}
+
+Vector2 FlowField::Sample(Vector2 position) const
+{
+    if (!IsActive()) return { 0.0f, 0.0f };
+
+    const int64_t cell = CellIndex(position);
+    if (cell < 0 || m_direction[cell] == NO_DIRECTION) return { 0.0f, 0.0f };
+    return DIRECTIONS[m_direction[cell]];
+}
@@ -0,0 +1,78 @@
+#include "GameSession.h"
+#include "EntityManager.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "Gun.h"
+#include "Sword.h"
+#include "WeaponPickup.h"
+#include "Random.h"
+#include "Logger.h"
+
+GameSession::GameSession(EntityManager& manager, uint64_t seed)
+    : m_manager(manager)
+    , m_seed(seed)
+    , m_tickIndex(0)
+    , m_hasActiveEnemy(false)
+{
+    m_manager.getRandom().Seed(seed);
+    m_manager.setWorldBounds({ 0.0f, 0.0f, ARENA_WIDTH, ARENA_HEIGHT });
+    m_manager.setAiLodView(ARENA_WIDTH, ARENA_HEIGHT);
+}
+
+// Helper function to create random weapon
+std::unique_ptr<Weapon> GameSession::CreateRandomWeapon() {
+    if (m_manager.getRandom().Range(0, 1) == 0) {
+        return std::make_unique<Gun>();
+    } else {
+        return std::make_unique<Sword>();
+    }
+}
+
+void GameSession::Start() {
+    // Create player (player number 0)
+    m_manager.queueEntity(std::make_unique<Player>(
+        Vector2{ ARENA_WIDTH / 2.0f, ARENA_HEIGHT / 2.0f },
+        0  // Player 1
+    ));
+
+    // Create first enemy with random weapon
+    auto firstEnemy = std::make_unique<Enemy>(Vector2{ 200.0f, 200.0f }, 100.0f, false);
+    firstEnemy->EquipWeapon(CreateRandomWeapon());
+    m_manager.queueEntity(std::move(firstEnemy));
+    m_hasActiveEnemy = true;
+
+    // Spawn test weapon pickup
+    m_manager.queueEntity(std::make_unique<WeaponPickup>(
+        Vector2{ ARENA_WIDTH / 2.0f, ARENA_HEIGHT / 2.0f - 100.0f },
+        std::make_unique<Gun>()
+    ));
+
+    // Spawn sword pickup
+    m_manager.queueEntity(std::make_unique<WeaponPickup>(
+        Vector2{ ARENA_WIDTH / 2.0f + 150.0f, ARENA_HEIGHT / 2.0f - 100.0f },
+        std::make_unique<Sword>()
+    ));
+}
+
+void GameSession::Tick(float deltaTime, const PlayerInput& input) {
+    // Check if current enemy is dead and spawn new one
+    if (!m_hasActiveEnemy) {
+        Vector2 spawnPos = { 200.0f, 200.0f };
+        auto newEnemy = std::make_unique<Enemy>(spawnPos, 100.0f, false);
+        newEnemy->EquipWeapon(CreateRandomWeapon());
+        m_manager.queueEntity(std::move(newEnemy));
+        m_hasActiveEnemy = true;
+        Logger::Info("Spawned new enemy with random weapon");
+    }
+
+    if (Player* player = m_manager.getPlayer(0)) {
+        player->SetInput(input);
+    }
+
+    // Targeting, spawning, update, collisions and cleanup
+    m_manager.step(deltaTime);
+
+    // Check if enemy is still alive
+    m_hasActiveEnemy = !m_manager.getEnemies().empty();
+    m_tickIndex++;
+}
@@ -2,7 +2,6 @@
 #include "Entity.h"
 #include "GunBullet.h"
 #include "EntityManager.h"
-#include "Logger.h"
 #include <cmath>
 
 Gun::Gun()
@@ -12,8 +11,6 @@ Gun::Gun()
 }
 
 void Gun::Fire(Entity* owner, Vector2 target) {
-    Logger::Debug("Gun::Fire");
-
     Vector2 ownerPos = owner->GetPosition();
 
     // Calculate direction
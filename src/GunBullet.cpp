@@ -1,34 +1,42 @@
 #include "GunBullet.h"
 #include "Enemy.h"
+#include "EntityManager.h"
 #include "Logger.h"
 
 GunBullet::GunBullet(Vector2 position, Vector2 velocity, float damage, Entity* owner)
-    : Entity(position, 5.0f, LAYER_PLAYER_ATTACK, LAYER_ENEMY | LAYER_ENEMY_ATTACK, owner),
-      m_velocity(velocity), m_damage(damage) {
+    : Entity(EntityKindOf<GunBullet>, position, 5.0f, LAYER_PLAYER_ATTACK, LAYER_ENEMY | LAYER_ENEMY_ATTACK, owner),
+      m_damage(damage) {
+    SetVelocity(velocity);
 }
 
 void GunBullet::Update(float deltaTime) {
-    m_position.x += m_velocity.x * deltaTime;
-    m_position.y += m_velocity.y * deltaTime;
+    Entity* self = this;
+    UpdateBatch(&self, 1, deltaTime);
+}
 
-    // Kill bullet if off-screen
-    if (m_position.x < 0 || m_position.x > 1280 ||
-        m_position.y < 0 || m_position.y > 720) {
-        Kill();
+void GunBullet::UpdateBatch(Entity* const* bullets, size_t count, float) {
+    // Movement was already integrated by the manager's movement pass,
+    // so all that's left is culling bullets that left the world
+    const EntityManager& manager = EntityManager::getInstance();
+    for (size_t i = 0; i < count; ++i) {
+        Entity* bullet = bullets[i];
+        if (manager.isOutsideWorld(bullet->GetPosition())) {
+            bullet->Kill();
+        }
     }
 }
 
 void GunBullet::Draw() const {
-    if (m_alive) {
-        DrawCircleV(m_position, m_radius, YELLOW);
+    if (IsAlive()) {
+        DrawCircleV(GetRenderPosition(), GetRadius(), YELLOW);
     }
 }
 
 void GunBullet::OnCollision(Entity* other) {
-    if (other == m_owner) return;
+    if (other->GetHandle() == m_owner) return;
 
     if (other->GetCollisionLayer() & LAYER_ENEMY) {
-        if (auto* enemy = dynamic_cast<Enemy*>(other)) {
+        if (auto* enemy = EntityCast<Enemy>(other)) {
             Logger::Debug("GunBullet hit enemy for ", m_damage, " damage");
             enemy->TakeDamage(m_damage);
         }
@@ -0,0 +1,152 @@
+#include "HierarchicalGrid.h"
+#include <algorithm>
+
+HierarchicalGrid::HierarchicalGrid(float baseCellSize)
+    : m_levelCounts{}
+{
+    SetBaseCellSize(baseCellSize);
+}
+
+void HierarchicalGrid::SetBaseCellSize(float baseCellSize)
+{
+    float cellSize = baseCellSize;
+    for (LayeredSpatialHash& level : m_levels) {
+        level.SetCellSize(cellSize);
+        cellSize *= LEVEL_RATIO;
+    }
+    Clear();
+}
+
+void HierarchicalGrid::SetBounds(Rectangle bounds)
+{
+    for (LayeredSpatialHash& level : m_levels) {
+        level.SetBounds(bounds);
+    }
+    Clear();
+}
+
+void HierarchicalGrid::ClearBounds()
+{
+    for (LayeredSpatialHash& level : m_levels) {
+        level.ClearBounds();
+    }
+    Clear();
+}
+
+void HierarchicalGrid::SetMode(SpatialHashMode mode)
+{
+    for (LayeredSpatialHash& level : m_levels) {
+        level.SetMode(mode);
+    }
+    Clear();
+}
+
+void HierarchicalGrid::Clear()
+{
+    for (LayeredSpatialHash& level : m_levels) {
+        level.Clear();
+    }
+    m_levelCounts.fill(0);
+    std::fill(m_slotLevel.begin(), m_slotLevel.end(), NO_LEVEL);
+}
+
+uint8_t HierarchicalGrid::LevelFor(float radius) const
+{
+    const float diameter = radius * 2.0f;
+    for (uint32_t level = 0; level + 1 < LEVEL_COUNT; ++level) {
+        if (diameter <= m_levels[level].GetCellSize()) {
+            return static_cast<uint8_t>(level);
+        }
+    }
+    return LEVEL_COUNT - 1;
+}
+
+void HierarchicalGrid::Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    if (IsIncremental()) {
+        Update(slot, position, radius, layer, mask);
+        return;
+    }
+    if (layer == LAYER_NONE) return;
+
+    if (slot >= m_slotLevel.size()) {
+        m_slotLevel.resize(slot + 1, NO_LEVEL);
+        m_slotBounds.resize(slot + 1);
+    }
+    const uint8_t level = LevelFor(radius);
+    m_levels[level].Insert(slot, position, radius, layer, mask);
+    m_levelCounts[level]++;
+    m_slotLevel[slot] = level;
+    m_slotBounds[slot] = { position, radius, mask };
+}
+
+void HierarchicalGrid::Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    if (!IsIncremental()) {
+        Insert(slot, position, radius, layer, mask);
+        return;
+    }
+
+    if (slot >= m_slotLevel.size()) {
+        m_slotLevel.resize(slot + 1, NO_LEVEL);
+        m_slotBounds.resize(slot + 1);
+    }
+    const uint8_t level = layer == LAYER_NONE ? NO_LEVEL : LevelFor(radius);
+    if (m_slotLevel[slot] != level) {
+        Remove(slot);
+    }
+    if (level == NO_LEVEL) return;
+
+    m_levels[level].Update(slot, position, radius, layer, mask);
+    if (m_slotLevel[slot] != level) {
+        m_slotLevel[slot] = level;
+        m_levelCounts[level]++;
+    }
+    m_slotBounds[slot] = { position, radius, mask };
+}
+
+void HierarchicalGrid::Remove(uint32_t slot)
+{
+    if (slot >= m_slotLevel.size() || m_slotLevel[slot] == NO_LEVEL) return;
+
+    const uint8_t level = m_slotLevel[slot];
+    m_levels[level].Remove(slot);
+    m_levelCounts[level]--;
+    m_slotLevel[slot] = NO_LEVEL;
+}
+
+void HierarchicalGrid::Truncate(uint32_t slotCount)
+{
+    for (uint32_t slot = slotCount; slot < m_slotLevel.size(); ++slot) {
+        Remove(slot);
+    }
+}
+
+void HierarchicalGrid::CollectCandidatePairs(std::vector<CandidatePair>& pairs)
+{
+    pairs.clear();
+
+    // Same-size entities: each level's own grid
+    for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+        if (m_levelCounts[level] > 1) {
+            m_levels[level].ForEachCandidatePair([&pairs](uint32_t a, uint32_t b) {
+                pairs.push_back({ a, b });
+            });
+        }
+    }
+
+    // Across levels: look each entity up in the coarser levels
+    for (uint32_t slot = 0; slot < m_slotLevel.size(); ++slot) {
+        const uint8_t level = m_slotLevel[slot];
+        if (level == NO_LEVEL) continue;
+
+        const SlotBounds& bounds = m_slotBounds[slot];
+        for (uint32_t coarser = level + 1u; coarser < LEVEL_COUNT; ++coarser) {
+            if (m_levelCounts[coarser] == 0) continue;
+            m_levels[coarser].ForEachInRadius(bounds.position, bounds.radius, bounds.mask,
+                                              [&pairs, slot](uint32_t other) {
+                pairs.push_back({ slot, other });
+            });
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include "InputLog.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+constexpr char LOG_MAGIC[4] = { 'P', 'O', 'I', 'L' };
+constexpr uint32_t LOG_VERSION = 1;
+
+constexpr uint8_t BUTTON_FIRE = 1 << 0;
+constexpr uint8_t BUTTON_INTERACT = 1 << 1;
+
+bool isBigEndian() {
+    uint16_t probe = 1;
+    uint8_t firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 0;
+}
+
+// Fixed little-endian encoding so logs are portable between machines
+template<typename T>
+void writeValue(std::ofstream& out, T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (isBigEndian()) std::reverse(bytes, bytes + sizeof(T));
+    out.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::ifstream& in, T& value) {
+    uint8_t bytes[sizeof(T)];
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(T))) return false;
+    if (isBigEndian()) std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+    return true;
+}
+
+int8_t quantizeAxis(float value) {
+    float clamped = std::max(-1.0f, std::min(1.0f, value));
+    return static_cast<int8_t>(std::lround(clamped * 127.0f));
+}
+}
+
+InputLog::InputLog(uint64_t seed, float tickRate, uint32_t playerCount)
+    : m_seed(seed)
+    , m_tickRate(tickRate)
+    , m_playerCount(playerCount > 0 ? playerCount : 1)
+{
+}
+
+bool InputLog::Record::operator==(const Record& other) const {
+    return moveX == other.moveX && moveY == other.moveY && buttons == other.buttons &&
+           aimX == other.aimX && aimY == other.aimY;
+}
+
+InputLog::Record InputLog::Encode(const PlayerInput& input) {
+    Record record;
+    record.moveX = quantizeAxis(input.movement.x);
+    record.moveY = quantizeAxis(input.movement.y);
+    record.buttons = (input.fire ? BUTTON_FIRE : 0) | (input.interact ? BUTTON_INTERACT : 0);
+    record.aimX = input.aimTarget.x;
+    record.aimY = input.aimTarget.y;
+    return record;
+}
+
+PlayerInput InputLog::Decode(const Record& record) {
+    PlayerInput input;
+    input.movement = { record.moveX / 127.0f, record.moveY / 127.0f };
+    input.aimTarget = { record.aimX, record.aimY };
+    input.fire = (record.buttons & BUTTON_FIRE) != 0;
+    input.interact = (record.buttons & BUTTON_INTERACT) != 0;
+    return input;
+}
+
+PlayerInput InputLog::Append(const PlayerInput& input) {
+    m_records.push_back(Encode(input));
+    return Decode(m_records.back());
+}
+
+PlayerInput InputLog::Get(uint32_t tick, uint32_t player) const {
+    size_t index = static_cast<size_t>(tick) * m_playerCount + player;
+    if (index >= m_records.size()) {
+        return PlayerInput{};
+    }
+    return Decode(m_records[index]);
+}
+
+bool InputLog::Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        Logger::Error("Could not open input log for writing: ", path);
+        return false;
+    }
+
+    out.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+    writeValue(out, LOG_VERSION);
+    writeValue(out, m_seed);
+    writeValue(out, m_tickRate);
+    writeValue(out, m_playerCount);
+    writeValue(out, static_cast<uint32_t>(m_records.size()));
+    writeValue(out, m_summary.finalEntityCount);
+    writeValue(out, m_summary.totalCandidatePairs);
+    writeValue(out, m_summary.totalContacts);
+
+    // Run-length encode: held keys and a still mouse repeat for many ticks
+    size_t i = 0;
+    while (i < m_records.size()) {
+        size_t run = 1;
+        while (i + run < m_records.size() && run < UINT16_MAX && m_records[i + run] == m_records[i]) {
+            run++;
+        }
+
+        const Record& record = m_records[i];
+        writeValue(out, static_cast<uint16_t>(run));
+        writeValue(out, record.moveX);
+        writeValue(out, record.moveY);
+        writeValue(out, record.buttons);
+        writeValue(out, record.aimX);
+        writeValue(out, record.aimY);
+        i += run;
+    }
+
+    if (!out) {
+        Logger::Error("Failed writing input log: ", path);
+        return false;
+    }
+    return true;
+}
+
+bool InputLog::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        Logger::Error("Could not open input log: ", path);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t recordCount = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(in, version) || version != LOG_VERSION) {
+        Logger::Error("Not a supported input log: ", path);
+        return false;
+    }
+
+    bool ok = readValue(in, m_seed) && readValue(in, m_tickRate) &&
+              readValue(in, m_playerCount) && readValue(in, recordCount) &&
+              readValue(in, m_summary.finalEntityCount) &&
+              readValue(in, m_summary.totalCandidatePairs) &&
+              readValue(in, m_summary.totalContacts);
+    if (!ok || m_playerCount == 0 || m_tickRate <= 0.0f) {
+        Logger::Error("Corrupt input log header: ", path);
+        return false;
+    }
+
+    m_records.clear();
+    m_records.reserve(recordCount);
+    while (m_records.size() < recordCount) {
+        uint16_t run = 0;
+        Record record;
+        ok = readValue(in, run) && readValue(in, record.moveX) && readValue(in, record.moveY) &&
+             readValue(in, record.buttons) && readValue(in, record.aimX) && readValue(in, record.aimY);
+        if (!ok || run == 0 || m_records.size() + run > recordCount) {
+            Logger::Error("Corrupt input log body: ", path);
+            m_records.clear();
+            return false;
+        }
+        m_records.insert(m_records.end(), run, record);
+    }
+    return true;
+}
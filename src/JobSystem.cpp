@@ -0,0 +1,136 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+    thread_local unsigned t_workerIndex = 0;
+}
+
+void JobSystem::WorkQueue::Push(const Job& job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(job);
+}
+
+bool JobSystem::WorkQueue::PopBack(Job& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (head == jobs.size()) return false;
+
+    out = jobs.back();
+    jobs.pop_back();
+    if (head == jobs.size()) {
+        jobs.clear();
+        head = 0;
+    }
+    return true;
+}
+
+bool JobSystem::WorkQueue::StealFront(Job& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (head == jobs.size()) return false;
+
+    out = jobs[head++];
+    if (head == jobs.size()) {
+        jobs.clear();
+        head = 0;
+    }
+    return true;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_queues = std::vector<WorkQueue>(workerCount);
+
+    // Worker 0 is whichever thread calls ParallelFor
+    for (unsigned worker = 1; worker < workerCount; ++worker) {
+        m_threads.emplace_back(&JobSystem::WorkerLoop, this, worker);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+unsigned JobSystem::CurrentWorker()
+{
+    return t_workerIndex;
+}
+
+void JobSystem::Dispatch(size_t count, size_t chunkSize, void* context, JobFn run)
+{
+    if (count == 0) return;
+    chunkSize = std::max<size_t>(chunkSize, 1);
+
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    const unsigned workers = GetWorkerCount();
+
+    m_pending.store(chunkCount, std::memory_order_relaxed);
+
+    {
+        // Count the jobs before any can be popped, so a worker's decrement
+        // never runs ahead of the increment and wraps the counter
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_queued.fetch_add(chunkCount, std::memory_order_release);
+
+        // Deal chunks round-robin; stealing evens out whatever imbalance remains
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+            m_queues[chunk % workers].Push({ run, context, chunk, begin, end });
+        }
+    }
+    m_wake.notify_all();
+
+    // Help out until the whole dispatch is done
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunJob(0)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::TryRunJob(unsigned worker)
+{
+    const unsigned workers = GetWorkerCount();
+    Job job;
+
+    bool found = m_queues[worker].PopBack(job);
+    for (unsigned offset = 1; !found && offset < workers; ++offset) {
+        found = m_queues[(worker + offset) % workers].StealFront(job);
+    }
+    if (!found) return false;
+
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    job.run(job.context, job.chunk, job.begin, job.end);
+    m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::WorkerLoop(unsigned worker)
+{
+    t_workerIndex = worker;
+
+    while (true) {
+        if (TryRunJob(worker)) continue;
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait(lock, [this] {
+            return m_stop || m_queued.load(std::memory_order_acquire) > 0;
+        });
+        if (m_stop) return;
+    }
+}
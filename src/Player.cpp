@@ -6,7 +6,7 @@
 #include <algorithm>
 
 Player::Player(Vector2 position, int playerNumber)
-    : Entity(position, 20.0f,
+    : Entity(EntityKindOf<Player>, position, 20.0f,
              1 << playerNumber,  // LAYER_PLAYER_1, LAYER_PLAYER_2, etc.
              LAYER_ENEMY | LAYER_ENEMY_ATTACK | LAYER_NEUTRAL_HAZARD | LAYER_PICKUP)
     , m_playerNumber(playerNumber)
@@ -28,12 +28,8 @@ void Player::Update(float deltaTime)
 
 void Player::HandleInput(float deltaTime)
 {
-    // Movement (WASD)
-    Vector2 movement = { 0.0f, 0.0f };
-    if (IsKeyDown(KEY_W)) movement.y -= 1.0f;
-    if (IsKeyDown(KEY_S)) movement.y += 1.0f;
-    if (IsKeyDown(KEY_A)) movement.x -= 1.0f;
-    if (IsKeyDown(KEY_D)) movement.x += 1.0f;
+    // Movement
+    Vector2 movement = m_input.movement;
 
     // Normalize diagonal movement
     float magnitude = std::sqrt(movement.x * movement.x + movement.y * movement.y);
@@ -44,18 +40,24 @@ void Player::HandleInput(float deltaTime)
     }
 
     // Apply movement
-    m_position.x += movement.x * m_speed * deltaTime;
-    m_position.y += movement.y * m_speed * deltaTime;
+    Vector2 position = GetPosition();
+    float radius = GetRadius();
+    position.x += movement.x * m_speed * deltaTime;
+    position.y += movement.y * m_speed * deltaTime;
 
     // Keep player in bounds
-    m_position.x = std::clamp(m_position.x, m_radius, 1280.0f - m_radius);
-    m_position.y = std::clamp(m_position.y, m_radius, 720.0f - m_radius);
+    Rectangle bounds = EntityManager::getInstance().getWorldBounds();
+    if (bounds.width > 0.0f && bounds.height > 0.0f)
+    {
+        position.x = std::clamp(position.x, bounds.x + radius, bounds.x + bounds.width - radius);
+        position.y = std::clamp(position.y, bounds.y + radius, bounds.y + bounds.height - radius);
+    }
+    SetPosition(position);
 
     // Shooting
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON))
+    if (m_input.fire)
     {
-        Vector2 mousePos = GetMousePosition();
-        Shoot(mousePos);
+        Shoot(m_input.aimTarget);
     }
 }
 
@@ -73,19 +75,22 @@ void Player::Shoot(Vector2 target)
 
 void Player::Draw() const
 {
-    if (m_alive)
+    if (IsAlive())
     {
+        Vector2 position = GetRenderPosition();
+        float radius = GetRadius();
+
         // Draw player with different colors per player number
         Color playerColors[] = { BLUE, GREEN, PURPLE, ORANGE };
         Color playerColor = playerColors[m_playerNumber % 4];
 
-        DrawCircleV(m_position, m_radius, playerColor);
+        DrawCircleV(position, radius, playerColor);
 
         // Calculate aim direction
-        Vector2 mousePos = GetMousePosition();
+        Vector2 aimTarget = m_input.aimTarget;
         Vector2 aimDir = {
-            mousePos.x - m_position.x,
-            mousePos.y - m_position.y
+            aimTarget.x - position.x,
+            aimTarget.y - position.y
         };
         float magnitude = std::sqrt(aimDir.x * aimDir.x + aimDir.y * aimDir.y);
         if (magnitude > 0.0f) {
@@ -95,18 +100,18 @@ void Player::Draw() const
 
         // Draw weapon if equipped
         if (m_weapon) {
-            m_weapon->Draw(m_position, aimDir);
+            m_weapon->Draw(position, aimDir);
         }
 
         // Draw direction indicator
-        DrawLineEx(m_position, mousePos, 2.0f, Fade(playerColor, 0.3f));
+        DrawLineEx(position, aimTarget, 2.0f, Fade(playerColor, 0.3f));
 
         // Draw health bar above player
         float barWidth = 50.0f;
         float barHeight = 5.0f;
         float healthPercent = m_health / m_maxHealth;
 
-        Vector2 barPos = { m_position.x - barWidth / 2, m_position.y - m_radius - 15.0f };
+        Vector2 barPos = { position.x - barWidth / 2, position.y - radius - 15.0f };
         DrawRectangle(barPos.x, barPos.y, barWidth, barHeight, DARKGRAY);
         DrawRectangle(barPos.x, barPos.y, barWidth * healthPercent, barHeight, GREEN);
     }
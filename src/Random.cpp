@@ -0,0 +1,44 @@
+#include "Random.h"
+
+namespace {
+constexpr uint64_t PCG_MULTIPLIER = 6364136223846793005ULL;
+}
+
+void Random::Seed(uint64_t seed)
+{
+    m_seed = seed;
+
+    // Standard PCG32 seeding: stream from the seed, then warm up the state
+    m_state = 0;
+    m_increment = (seed << 1u) | 1u;
+    NextU32();
+    m_state += seed;
+    NextU32();
+}
+
+uint32_t Random::NextU32()
+{
+    uint64_t old = m_state;
+    m_state = old * PCG_MULTIPLIER + m_increment;
+
+    uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+}
+
+int Random::Range(int min, int max)
+{
+    if (max <= min) return min;
+
+    // Multiply-shift maps 32 random bits onto the span without a modulo
+    uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t offset = (static_cast<uint64_t>(NextU32()) * span) >> 32;
+    return static_cast<int>(min + static_cast<int64_t>(offset));
+}
+
+float Random::Range(float min, float max)
+{
+    // 24 random bits fill a float mantissa exactly
+    float unit = static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f);
+    return min + (max - min) * unit;
+}
@@ -0,0 +1,126 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <iterator>
+
+void SweepAndPrune::EnsureSlot(uint32_t slot)
+{
+    if (slot >= m_slotBounds.size()) {
+        m_slotBounds.resize(slot + 1);
+        m_present.resize(slot + 1, 0);
+        m_listed.resize(slot + 1, 0);
+    }
+}
+
+void SweepAndPrune::Clear()
+{
+    // Keep the sweep list: the same entities usually come back next frame
+    std::fill(m_present.begin(), m_present.end(), 0);
+}
+
+void SweepAndPrune::Insert(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    Update(slot, position, radius, layer, mask);
+}
+
+void SweepAndPrune::Update(uint32_t slot, Vector2 position, float radius, uint32_t layer, uint32_t mask)
+{
+    if (layer == 0) {
+        Remove(slot);
+        return;
+    }
+
+    EnsureSlot(slot);
+    m_slotBounds[slot] = Interval{ position.x - radius, position.x + radius,
+                                   position.y - radius, position.y + radius,
+                                   layer, mask, slot };
+    m_present[slot] = 1;
+}
+
+void SweepAndPrune::Remove(uint32_t slot)
+{
+    if (slot < m_present.size()) {
+        m_present[slot] = 0;
+    }
+}
+
+void SweepAndPrune::Truncate(uint32_t slotCount)
+{
+    for (uint32_t slot = slotCount; slot < m_present.size(); ++slot) {
+        m_present[slot] = 0;
+    }
+}
+
+void SweepAndPrune::Refresh()
+{
+    auto byMinX = [](const Interval& a, const Interval& b) { return a.minX < b.minX; };
+
+    // Compact out removed slots and pick up the new bounds, keeping last
+    // frame's order
+    size_t kept = 0;
+    for (size_t i = 0; i < m_intervals.size(); ++i) {
+        uint32_t slot = m_intervals[i].slot;
+        if (m_present[slot]) {
+            m_intervals[kept++] = m_slotBounds[slot];
+        } else {
+            m_listed[slot] = 0;
+        }
+    }
+    m_intervals.resize(kept);
+
+    m_added.clear();
+    for (uint32_t slot = 0; slot < m_present.size(); ++slot) {
+        if (m_present[slot] && !m_listed[slot]) {
+            m_listed[slot] = 1;
+            m_added.push_back(m_slotBounds[slot]);
+        }
+    }
+
+    // Insertion sort of the kept entries: close to one linear pass when
+    // entities only moved a little. A slot renumbered by a swap-and-pop
+    // removal carries another entity's bounds and may travel far, so give
+    // up and fully sort once the shifting grows past a few passes' worth
+    Interval* intervals = m_intervals.data();
+    const size_t shiftBudget = INSERTION_SORT_PASSES * kept;
+    size_t shifts = 0;
+    for (size_t i = 1; i < kept && shifts <= shiftBudget; ++i) {
+        Interval moving = intervals[i];
+        size_t j = i;
+        while (j > 0 && intervals[j - 1].minX > moving.minX) {
+            intervals[j] = intervals[j - 1];
+            --j;
+        }
+        intervals[j] = moving;
+        shifts += i - j;
+    }
+    if (shifts > shiftBudget) {
+        std::stable_sort(m_intervals.begin(), m_intervals.end(), byMinX);
+    }
+
+    // New slots: sorted on their own, then merged in one linear pass
+    if (!m_added.empty()) {
+        std::stable_sort(m_added.begin(), m_added.end(), byMinX);
+        m_merged.clear();
+        m_merged.reserve(m_intervals.size() + m_added.size());
+        std::merge(m_intervals.begin(), m_intervals.end(), m_added.begin(), m_added.end(),
+                   std::back_inserter(m_merged), byMinX);
+        m_intervals.swap(m_merged);
+    }
+}
+
+void SweepAndPrune::CollectCandidatePairs(std::vector<CandidatePair>& pairs)
+{
+    pairs.clear();
+    Refresh();
+
+    const Interval* intervals = m_intervals.data();
+    const size_t count = m_intervals.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Interval& a = intervals[i];
+        for (size_t j = i + 1; j < count && intervals[j].minX <= a.maxX; ++j) {
+            const Interval& b = intervals[j];
+            if (b.maxY < a.minY || b.minY > a.maxY) continue;
+            if ((a.mask & b.layer) == 0 || (b.mask & a.layer) == 0) continue;
+            pairs.push_back({ a.slot, b.slot });
+        }
+    }
+}
@@ -2,7 +2,6 @@
 #include "EntityManager.h"
 #include "SwordSwing.h"
 #include "SwordSlam.h"
-#include "Logger.h"
 #include <cmath>
 #include <raylib.h>
 
@@ -79,8 +78,6 @@ void Sword::Fire(Entity* owner, Vector2 target) {
         m_currentCombo = ComboStage::Swing1_LeftRight;
     }
 
-    Logger::Debug("Sword::Fire - Combo stage: ", static_cast<int>(m_currentCombo));
-
     // Setup swing
     m_isSwinging = true;
     m_currentSwing = GetSwingConfig(m_currentCombo);
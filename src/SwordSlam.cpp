@@ -2,7 +2,7 @@
 #include <cmath>
 
 SwordSlam::SwordSlam(Entity* owner, Vector2 position, Vector2 direction, float damage, float range, float duration)
-    : Entity(position, range,
+    : Entity(EntityKindOf<SwordSlam>, position, range,
              owner->GetCollisionLayer() == LAYER_ENEMY ? LAYER_ENEMY_ATTACK : LAYER_PLAYER_ATTACK,
              owner->GetCollisionMask(),
              owner)
@@ -13,6 +13,7 @@ SwordSlam::SwordSlam(Entity* owner, Vector2 position, Vector2 direction, float d
     , m_direction(direction)
     , m_windupOffset({direction.x * -60.0f, direction.y * -60.0f})  // Raise sword back 60 pixels
     , m_impactPoint({position.x + direction.x * range, position.y + direction.y * range})  // Impact in front
+    , m_trailCount(0)
     , m_trailSpawnTimer(0.0f)
     , m_hasImpacted(false) {
 }
@@ -23,15 +24,25 @@ float SwordSlam::GetProgress() const {
 }
 
 Vector2 SwordSlam::GetCurrentSwordPosition() const {
+    return GetCurrentSwordPosition(GetPosition());
+}
+
+Vector2 SwordSlam::GetCurrentSwordPosition(Vector2 position) const {
     float progress = GetProgress();
+    // The impact point sits a fixed offset from the simulated position;
+    // keep that offset so the tip follows whichever base is passed in
+    Vector2 impactPoint = {
+        position.x + m_impactPoint.x - GetPosition().x,
+        position.y + m_impactPoint.y - GetPosition().y
+    };
 
     if (progress < 0.6f) {
         // Windup phase (60% of time) - slowly raise sword
         float windupProgress = progress / 0.6f;
         float eased = windupProgress * windupProgress;  // Ease-in
         return {
-            m_position.x + m_windupOffset.x * eased,
-            m_position.y + m_windupOffset.y * eased
+            position.x + m_windupOffset.x * eased,
+            position.y + m_windupOffset.y * eased
         };
     } else {
         // Slam phase (40% of time) - FAST crash down
@@ -39,13 +50,13 @@ Vector2 SwordSlam::GetCurrentSwordPosition() const {
         float eased = 1.0f - std::pow(1.0f - slamProgress, 4.0f);  // Ease-out quartic (very fast)
 
         Vector2 startPos = {
-            m_position.x + m_windupOffset.x,
-            m_position.y + m_windupOffset.y
+            position.x + m_windupOffset.x,
+            position.y + m_windupOffset.y
         };
 
         return {
-            startPos.x + (m_impactPoint.x - startPos.x) * eased,
-            startPos.y + (m_impactPoint.y - startPos.y) * eased
+            startPos.x + (impactPoint.x - startPos.x) * eased,
+            startPos.y + (impactPoint.y - startPos.y) * eased
         };
     }
 }
@@ -54,18 +65,21 @@ void SwordSlam::UpdateTrail(float deltaTime) {
     m_trailSpawnTimer -= deltaTime;
     if (m_trailSpawnTimer <= 0.0f) {
         Vector2 swordPos = GetCurrentSwordPosition();
-        m_trailPoints.push_back({swordPos, 0.15f});
+        if (m_trailCount < MAX_TRAIL_POINTS) {
+            m_trailPoints[m_trailCount++] = {swordPos, 0.15f};
+        }
         m_trailSpawnTimer = 0.015f;
     }
 
-    for (auto it = m_trailPoints.begin(); it != m_trailPoints.end();) {
-        it->lifetime -= deltaTime;
-        if (it->lifetime <= 0.0f) {
-            it = m_trailPoints.erase(it);
-        } else {
-            ++it;
+    size_t kept = 0;
+    for (size_t i = 0; i < m_trailCount; ++i) {
+        TrailPoint point = m_trailPoints[i];
+        point.lifetime -= deltaTime;
+        if (point.lifetime > 0.0f) {
+            m_trailPoints[kept++] = point;
         }
     }
+    m_trailCount = kept;
 }
 
 void SwordSlam::Update(float deltaTime) {
@@ -77,12 +91,14 @@ void SwordSlam::Update(float deltaTime) {
     }
 
     // Update position to follow owner
-    if (m_owner && m_owner->IsAlive()) {
-        m_position = m_owner->GetPosition();
+    Entity* owner = GetOwner();
+    if (owner && owner->IsAlive()) {
+        Vector2 position = owner->GetPosition();
+        SetPosition(position);
         // Update impact point to stay in front of owner
         m_impactPoint = {
-            m_position.x + m_direction.x * m_range,
-            m_position.y + m_direction.y * m_range
+            position.x + m_direction.x * m_range,
+            position.y + m_direction.y * m_range
         };
         // Update windup offset too
         m_windupOffset = {
@@ -102,13 +118,15 @@ void SwordSlam::Update(float deltaTime) {
 }
 
 void SwordSlam::Draw() const {
-    if (!m_alive) return;
+    if (!IsAlive()) return;
 
+    Vector2 position = GetRenderPosition();
     float progress = GetProgress();
-    Vector2 swordPos = GetCurrentSwordPosition();
+    Vector2 swordPos = GetCurrentSwordPosition(position);
 
     // Draw motion trail
-    for (const auto& point : m_trailPoints) {
+    for (size_t i = 0; i < m_trailCount; ++i) {
+        const TrailPoint& point = m_trailPoints[i];
         float alpha = point.lifetime / 0.15f;
         float size = 6.0f * alpha;
         DrawCircleV(point.position, size, Fade(ORANGE, alpha * 0.5f));
@@ -125,7 +143,7 @@ void SwordSlam::Draw() const {
 
         // Raised sword with glow
         DrawCircleV(swordPos, 25.0f, Fade(ORANGE, 0.4f + 0.3f * windupProgress));
-        DrawLineEx(m_position, swordPos, 8.0f, Fade(ORANGE, 0.6f));
+        DrawLineEx(position, swordPos, 8.0f, Fade(ORANGE, 0.6f));
     } else {
         // Slam phase - motion blur
         float slamProgress = (progress - 0.6f) / 0.4f;
@@ -138,7 +156,7 @@ void SwordSlam::Draw() const {
                 swordPos.y - offset
             };
             float alpha = 1.0f - (i / 5.0f);
-            DrawLineEx(m_position, blurPos, 12.0f, Fade(ORANGE, alpha * 0.3f));
+            DrawLineEx(position, blurPos, 12.0f, Fade(ORANGE, alpha * 0.3f));
         }
 
         // Impact flash when hitting
@@ -151,13 +169,13 @@ void SwordSlam::Draw() const {
 
     // Draw the blade
     float thickness = (progress >= 0.6f) ? 10.0f : 8.0f;
-    DrawLineEx(m_position, swordPos, thickness + 2.0f, Fade(ORANGE, 0.4f));
-    DrawLineEx(m_position, swordPos, thickness, Fade(ORANGE, 0.9f));
+    DrawLineEx(position, swordPos, thickness + 2.0f, Fade(ORANGE, 0.4f));
+    DrawLineEx(position, swordPos, thickness, Fade(ORANGE, 0.9f));
     DrawCircleV(swordPos, 12.0f, Fade(ORANGE, 0.8f));
 }
 
 void SwordSlam::OnCollision(Entity* other) {
-    if (other && other != m_owner && GetProgress() >= 0.9f) {
+    if (other && other->GetHandle() != m_owner && GetProgress() >= 0.9f) {
         // Only hit during the impact phase
     }
 }
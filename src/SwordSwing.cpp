@@ -4,7 +4,7 @@
 SwordSwing::SwordSwing(Entity* owner, Vector2 position, float damage, float range,
                        float duration, float startAngle, float endAngle,
                        Color swingColor)
-    : Entity(position, range,  // Use range as radius for collision
+    : Entity(EntityKindOf<SwordSwing>, position, range,  // Use range as radius for collision
              owner->GetCollisionLayer() == LAYER_ENEMY ? LAYER_ENEMY_ATTACK : LAYER_PLAYER_ATTACK,
              owner->GetCollisionMask(),
              owner)
@@ -15,6 +15,7 @@ SwordSwing::SwordSwing(Entity* owner, Vector2 position, float damage, float rang
     , m_startAngle(startAngle)
     , m_endAngle(endAngle)
     , m_color(swingColor)
+    , m_trailCount(0)
     , m_trailSpawnTimer(0.0f) {
 }
 
@@ -44,23 +45,27 @@ void SwordSwing::UpdateTrail(float deltaTime) {
     if (m_trailSpawnTimer <= 0.0f) {
         float currentAngle = GetCurrentAngle();
         float angleRad = currentAngle * DEG2RAD;
+        Vector2 position = GetPosition();
         Vector2 swordTip = {
-            m_position.x + std::cos(angleRad) * m_range,
-            m_position.y + std::sin(angleRad) * m_range
+            position.x + std::cos(angleRad) * m_range,
+            position.y + std::sin(angleRad) * m_range
         };
-        m_trailPoints.push_back({swordTip, 0.2f});  // 200ms lifetime
+        if (m_trailCount < MAX_TRAIL_POINTS) {
+            m_trailPoints[m_trailCount++] = {swordTip, 0.2f};  // 200ms lifetime
+        }
         m_trailSpawnTimer = 0.02f;  // Spawn every 20ms
     }
 
-    // Update and remove old trail points
-    for (auto it = m_trailPoints.begin(); it != m_trailPoints.end();) {
-        it->lifetime -= deltaTime;
-        if (it->lifetime <= 0.0f) {
-            it = m_trailPoints.erase(it);
-        } else {
-            ++it;
+    // Update and remove old trail points (compacting in place)
+    size_t kept = 0;
+    for (size_t i = 0; i < m_trailCount; ++i) {
+        TrailPoint point = m_trailPoints[i];
+        point.lifetime -= deltaTime;
+        if (point.lifetime > 0.0f) {
+            m_trailPoints[kept++] = point;
         }
     }
+    m_trailCount = kept;
 }
 
 void SwordSwing::Update(float deltaTime) {
@@ -73,8 +78,9 @@ void SwordSwing::Update(float deltaTime) {
     }
 
     // Update position to follow owner if they moved
-    if (m_owner && m_owner->IsAlive()) {
-        m_position = m_owner->GetPosition();
+    Entity* owner = GetOwner();
+    if (owner && owner->IsAlive()) {
+        SetPosition(owner->GetPosition());
     }
 
     // Update visual trail
@@ -82,19 +88,21 @@ void SwordSwing::Update(float deltaTime) {
 }
 
 void SwordSwing::Draw() const {
-    if (!m_alive) return;
+    if (!IsAlive()) return;
 
+    Vector2 position = GetRenderPosition();
     float currentAngle = GetCurrentAngle();
     float currentAngleRad = currentAngle * DEG2RAD;
 
     // Calculate sword tip position
     Vector2 swordEnd = {
-        m_position.x + std::cos(currentAngleRad) * m_range,
-        m_position.y + std::sin(currentAngleRad) * m_range
+        position.x + std::cos(currentAngleRad) * m_range,
+        position.y + std::sin(currentAngleRad) * m_range
     };
 
     // Draw motion trail
-    for (const auto& point : m_trailPoints) {
+    for (size_t i = 0; i < m_trailCount; ++i) {
+        const TrailPoint& point = m_trailPoints[i];
         float alpha = point.lifetime / 0.2f;
         DrawCircleV(point.position, 3.0f, Fade(m_color, alpha * 0.6f));
     }
@@ -107,8 +115,8 @@ void SwordSwing::Draw() const {
         float alpha = 1.0f - ((arcEndAngle - a) / 30.0f);
         float rad = a * DEG2RAD;
         Vector2 arcPoint = {
-            m_position.x + std::cos(rad) * m_range * 0.8f,
-            m_position.y + std::sin(rad) * m_range * 0.8f
+            position.x + std::cos(rad) * m_range * 0.8f,
+            position.y + std::sin(rad) * m_range * 0.8f
         };
         DrawCircleV(arcPoint, 2.0f, Fade(m_color, alpha * 0.3f));
     }
@@ -117,8 +125,8 @@ void SwordSwing::Draw() const {
     float bladeThickness = 5.0f;
 
     // Draw blade with glow
-    DrawLineEx(m_position, swordEnd, bladeThickness + 2.0f, Fade(m_color, 0.3f));
-    DrawLineEx(m_position, swordEnd, bladeThickness, Fade(m_color, 0.9f));
+    DrawLineEx(position, swordEnd, bladeThickness + 2.0f, Fade(m_color, 0.3f));
+    DrawLineEx(position, swordEnd, bladeThickness, Fade(m_color, 0.9f));
     DrawCircleV(swordEnd, 8.0f, Fade(m_color, 0.7f));
 }
 
@@ -0,0 +1,127 @@
+#include "TargetingKernel.h"
+#include "SimdIsa.h"
+#include <limits>
+
+namespace {
+// Scalar nearest-point search for queries [begin, end); the SIMD paths use
+// it for the leftover queries
+void FindNearestScalar(const float* pointX, const float* pointY, size_t pointCount,
+                       const float* queryX, const float* queryY, size_t begin, size_t end,
+                       uint32_t* outNearest)
+{
+    for (size_t i = begin; i < end; ++i) {
+        float bestDistanceSq = std::numeric_limits<float>::max();
+        uint32_t best = 0;
+        for (size_t p = 0; p < pointCount; ++p) {
+            float dx = pointX[p] - queryX[i];
+            float dy = pointY[p] - queryY[i];
+            float distanceSq = dx * dx + dy * dy;
+            if (distanceSq < bestDistanceSq) {
+                bestDistanceSq = distanceSq;
+                best = static_cast<uint32_t>(p);
+            }
+        }
+        outNearest[i] = best;
+    }
+}
+}
+
+#if defined(PUSH_ON_SIMD_AVX2)
+
+void TargetingKernel::FindNearest(const float* pointX, const float* pointY, size_t pointCount,
+                                  const float* queryX, const float* queryY, size_t queryCount,
+                                  uint32_t* outNearest)
+{
+    // Sixteen queries at a time, as two independent groups of eight so one
+    // group's compare/blend chain overlaps the other's; the best distances
+    // and indices stay in registers while every point is tested
+    size_t i = 0;
+    for (; i + 16 <= queryCount; i += 16) {
+        const __m256 x0 = _mm256_loadu_ps(queryX + i);
+        const __m256 y0 = _mm256_loadu_ps(queryY + i);
+        const __m256 x1 = _mm256_loadu_ps(queryX + i + 8);
+        const __m256 y1 = _mm256_loadu_ps(queryY + i + 8);
+        __m256 bestDistanceSq0 = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256 bestDistanceSq1 = bestDistanceSq0;
+        __m256i best0 = _mm256_setzero_si256();
+        __m256i best1 = best0;
+        for (size_t p = 0; p < pointCount; ++p) {
+            const __m256 px = _mm256_set1_ps(pointX[p]);
+            const __m256 py = _mm256_set1_ps(pointY[p]);
+            const __m256i index = _mm256_set1_epi32(static_cast<int>(p));
+
+            __m256 dx0 = _mm256_sub_ps(px, x0);
+            __m256 dy0 = _mm256_sub_ps(py, y0);
+            __m256 distanceSq0 = _mm256_add_ps(_mm256_mul_ps(dx0, dx0), _mm256_mul_ps(dy0, dy0));
+            __m256 closer0 = _mm256_cmp_ps(distanceSq0, bestDistanceSq0, _CMP_LT_OQ);
+            bestDistanceSq0 = _mm256_blendv_ps(bestDistanceSq0, distanceSq0, closer0);
+            best0 = _mm256_blendv_epi8(best0, index, _mm256_castps_si256(closer0));
+
+            __m256 dx1 = _mm256_sub_ps(px, x1);
+            __m256 dy1 = _mm256_sub_ps(py, y1);
+            __m256 distanceSq1 = _mm256_add_ps(_mm256_mul_ps(dx1, dx1), _mm256_mul_ps(dy1, dy1));
+            __m256 closer1 = _mm256_cmp_ps(distanceSq1, bestDistanceSq1, _CMP_LT_OQ);
+            bestDistanceSq1 = _mm256_blendv_ps(bestDistanceSq1, distanceSq1, closer1);
+            best1 = _mm256_blendv_epi8(best1, index, _mm256_castps_si256(closer1));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(outNearest + i), best0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(outNearest + i + 8), best1);
+    }
+    FindNearestScalar(pointX, pointY, pointCount, queryX, queryY, i, queryCount, outNearest);
+}
+
+#elif defined(PUSH_ON_SIMD_SSE2)
+
+void TargetingKernel::FindNearest(const float* pointX, const float* pointY, size_t pointCount,
+                                  const float* queryX, const float* queryY, size_t queryCount,
+                                  uint32_t* outNearest)
+{
+    // Eight queries at a time, as two independent groups of four (see the
+    // AVX2 version); SSE2 has no blend, so select with and/andnot
+    size_t i = 0;
+    for (; i + 8 <= queryCount; i += 8) {
+        const __m128 x0 = _mm_loadu_ps(queryX + i);
+        const __m128 y0 = _mm_loadu_ps(queryY + i);
+        const __m128 x1 = _mm_loadu_ps(queryX + i + 4);
+        const __m128 y1 = _mm_loadu_ps(queryY + i + 4);
+        __m128 bestDistanceSq0 = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128 bestDistanceSq1 = bestDistanceSq0;
+        __m128i best0 = _mm_setzero_si128();
+        __m128i best1 = best0;
+        for (size_t p = 0; p < pointCount; ++p) {
+            const __m128 px = _mm_set1_ps(pointX[p]);
+            const __m128 py = _mm_set1_ps(pointY[p]);
+            const __m128i index = _mm_set1_epi32(static_cast<int>(p));
+
+            __m128 dx0 = _mm_sub_ps(px, x0);
+            __m128 dy0 = _mm_sub_ps(py, y0);
+            __m128 distanceSq0 = _mm_add_ps(_mm_mul_ps(dx0, dx0), _mm_mul_ps(dy0, dy0));
+            __m128 closer0 = _mm_cmplt_ps(distanceSq0, bestDistanceSq0);
+            bestDistanceSq0 = _mm_or_ps(_mm_and_ps(closer0, distanceSq0), _mm_andnot_ps(closer0, bestDistanceSq0));
+            __m128i closerInt0 = _mm_castps_si128(closer0);
+            best0 = _mm_or_si128(_mm_and_si128(closerInt0, index), _mm_andnot_si128(closerInt0, best0));
+
+            __m128 dx1 = _mm_sub_ps(px, x1);
+            __m128 dy1 = _mm_sub_ps(py, y1);
+            __m128 distanceSq1 = _mm_add_ps(_mm_mul_ps(dx1, dx1), _mm_mul_ps(dy1, dy1));
+            __m128 closer1 = _mm_cmplt_ps(distanceSq1, bestDistanceSq1);
+            bestDistanceSq1 = _mm_or_ps(_mm_and_ps(closer1, distanceSq1), _mm_andnot_ps(closer1, bestDistanceSq1));
+            __m128i closerInt1 = _mm_castps_si128(closer1);
+            best1 = _mm_or_si128(_mm_and_si128(closerInt1, index), _mm_andnot_si128(closerInt1, best1));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outNearest + i), best0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outNearest + i + 4), best1);
+    }
+    FindNearestScalar(pointX, pointY, pointCount, queryX, queryY, i, queryCount, outNearest);
+}
+
+#else
+
+void TargetingKernel::FindNearest(const float* pointX, const float* pointY, size_t pointCount,
+                                  const float* queryX, const float* queryY, size_t queryCount,
+                                  uint32_t* outNearest)
+{
+    FindNearestScalar(pointX, pointY, pointCount, queryX, queryY, 0, queryCount, outNearest);
+}
+
+#endif
@@ -5,34 +5,38 @@
 #include <cmath>
 
 WeaponPickup::WeaponPickup(Vector2 position, std::unique_ptr<Weapon> weapon)
-    : Entity(position, 15.0f, LAYER_PICKUP, LAYER_ALL_PLAYERS, nullptr),
+    : Entity(EntityKindOf<WeaponPickup>, position, 15.0f, LAYER_PICKUP, LAYER_ALL_PLAYERS, nullptr),
       m_weapon(std::move(weapon)),
-      m_bobTime(0.0f),
-      m_nearbyPlayer(nullptr) {
+      m_bobTime(0.0f) {
 }
 
 void WeaponPickup::Update(float deltaTime) {
     m_bobTime += deltaTime * 2.0f;  // Bob animation speed
 
-    // Check if player presses E to pick up weapon
-    if (m_nearbyPlayer && IsKeyPressed(KEY_E)) {
-        PickupWeapon(m_nearbyPlayer);
+    // Check if the nearby player pressed interact to pick up weapon
+    if (m_nearbyPlayer.IsValid()) {
+        Entity* nearby = EntityManager::getInstance().resolve(m_nearbyPlayer);
+        auto* player = EntityCast<Player>(nearby);
+        if (player && player->GetInput().interact) {
+            PickupWeapon(player);
+        }
     }
 
     // Reset nearby player each frame (will be set by OnCollision if still near)
-    m_nearbyPlayer = nullptr;
+    m_nearbyPlayer = EntityHandle{};
 }
 
 void WeaponPickup::Draw() const {
-    if (!m_alive || !m_weapon) return;
+    if (!IsAlive() || !m_weapon) return;
 
     // Floating animation
     float bobOffset = std::sin(m_bobTime) * 5.0f;
-    Vector2 drawPos = { m_position.x, m_position.y + bobOffset };
+    Vector2 position = GetRenderPosition();
+    Vector2 drawPos = { position.x, position.y + bobOffset };
 
     // Draw as a box with weapon name
-    DrawCircleV(drawPos, m_radius, GOLD);
-    DrawCircleLinesV(drawPos, m_radius, ORANGE);
+    DrawCircleV(drawPos, GetRadius(), GOLD);
+    DrawCircleLinesV(drawPos, GetRadius(), ORANGE);
 
     // Draw weapon name below
     const char* name = m_weapon->GetName().c_str();
@@ -40,7 +44,7 @@ void WeaponPickup::Draw() const {
     DrawText(name, drawPos.x - textWidth / 2, drawPos.y + 20, 10, WHITE);
 
     // Draw "Press E" prompt if player is nearby
-    if (m_nearbyPlayer) {
+    if (m_nearbyPlayer.IsValid()) {
         const char* prompt = "Press E";
         int promptWidth = MeasureText(prompt, 12);
         DrawText(prompt, drawPos.x - promptWidth / 2, drawPos.y - 30, 12, YELLOW);
@@ -51,8 +55,8 @@ void WeaponPickup::OnCollision(Entity* other) {
     if (!m_weapon) return;
 
     // Track nearby player for 'E' key check
-    if (auto* player = dynamic_cast<Player*>(other)) {
-        m_nearbyPlayer = player;
+    if (auto* player = EntityCast<Player>(other)) {
+        m_nearbyPlayer = player->GetHandle();
     }
 }
 
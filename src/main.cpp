@@ -1,105 +1,111 @@
 #include "EntityManager.h"
 #include "raylib.h"
 #include "Player.h"
-#include "Enemy.h"
-#include "Gun.h"
-#include "Sword.h"
-#include "WeaponPickup.h"
+#include "GunBullet.h"
+#include "SwordSwing.h"
+#include "SwordSlam.h"
+#include "ObjectPool.h"
+#include "PlayerInput.h"
+#include "FixedTimestep.h"
+#include "GameSession.h"
+#include "InputLog.h"
 #include <memory>
 #include <string>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include "Logger.h"
 
 constexpr int SCREEN_WIDTH = 1280;
 constexpr int SCREEN_HEIGHT = 720;
 constexpr int TARGET_FPS = 60;
-
-// Helper function to create random weapon
-std::unique_ptr<Weapon> CreateRandomWeapon() {
-    int choice = rand() % 2;
-    if (choice == 0) {
-        return std::make_unique<Gun>();
-    } else {
-        return std::make_unique<Sword>();
-    }
+constexpr float DEFAULT_TICK_RATE = 60.0f;  // Simulation ticks per second (--tick-rate N)
+
+// Read keyboard/mouse into the controls for the local player
+PlayerInput PollPlayerInput() {
+    PlayerInput input;
+    if (IsKeyDown(KEY_W)) input.movement.y -= 1.0f;
+    if (IsKeyDown(KEY_S)) input.movement.y += 1.0f;
+    if (IsKeyDown(KEY_A)) input.movement.x -= 1.0f;
+    if (IsKeyDown(KEY_D)) input.movement.x += 1.0f;
+    input.aimTarget = GetMousePosition();
+    input.fire = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    input.interact = IsKeyPressed(KEY_E);
+    return input;
 }
 
-int main(void)
+int main(int argc, char** argv)
 {
+    // Options: --tick-rate N, --seed N, --record FILE
+    float tickRate = DEFAULT_TICK_RATE;
+    uint64_t seed = static_cast<uint64_t>(time(nullptr));
+    std::string recordPath;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--tick-rate") == 0) {
+            float requested = static_cast<float>(std::atof(argv[++i]));
+            if (requested > 0.0f) tickRate = requested;
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--record") == 0) {
+            recordPath = argv[++i];
+        }
+    }
+    FixedTimestep timestep(tickRate);
+
     // Initialization
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Push On");
     SetTargetFPS(TARGET_FPS);
-    srand(time(nullptr));  // Seed random number generator
 
     // Get EntityManager instance
     EntityManager& manager = EntityManager::getInstance();
 
-    // Create player (player number 0)
-    manager.queueEntity(std::make_unique<Player>(
-        Vector2{ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f },
-        0  // Player 1
-    ));
-
-    // Create first enemy with random weapon
-    auto firstEnemy = std::make_unique<Enemy>(Vector2{ 200.0f, 200.0f }, 100.0f, false);
-    firstEnemy->EquipWeapon(CreateRandomWeapon());
-    manager.queueEntity(std::move(firstEnemy));
+    // Pre-size the attack pools so combat doesn't touch the heap
+    ObjectPool<GunBullet>::Instance().Reserve(1024);
+    ObjectPool<SwordSwing>::Instance().Reserve(64);
+    ObjectPool<SwordSlam>::Instance().Reserve(64);
 
-    // Spawn test weapon pickup
-    manager.queueEntity(std::make_unique<WeaponPickup>(
-        Vector2{ SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f - 100.0f },
-        std::make_unique<Gun>()
-    ));
+    // Scene setup and respawns live in the session so replays match
+    GameSession session(manager, seed);
+    session.Start();
 
-    // Spawn sword pickup
-    manager.queueEntity(std::make_unique<WeaponPickup>(
-        Vector2{ SCREEN_WIDTH / 2.0f + 150.0f, SCREEN_HEIGHT / 2.0f - 100.0f },
-        std::make_unique<Sword>()
-    ));
+    // Every tick's input goes here when recording (--record)
+    InputLog inputLog(seed, tickRate, 1);
+    InputLog::Summary recordedTotals;
+    bool recording = !recordPath.empty();
 
-    // Track if we need to spawn a new enemy
-    bool hasActiveEnemy = true;
+    // Interact presses wait here until a tick consumes them, so a press on a
+    // frame that runs no ticks isn't lost (and isn't repeated on the next ones)
+    bool pendingInteract = false;
 
     // Main game loop
     while (!WindowShouldClose())
     {
-        float deltaTime = GetFrameTime();
-
-        // Check if current enemy is dead and spawn new one
-        if (!hasActiveEnemy) {
-            Vector2 spawnPos = { 200.0f, 200.0f };
-            auto newEnemy = std::make_unique<Enemy>(spawnPos, 100.0f, false);
-            newEnemy->EquipWeapon(CreateRandomWeapon());
-            manager.queueEntity(std::move(newEnemy));
-            hasActiveEnemy = true;
-            Logger::Info("Spawned new enemy with random weapon");
-        }
-
-        // Update enemy AI - enemies chase closest player (clean, no casting!)
-        for (Enemy* enemy : manager.getEnemies()) {
-            if (Player* target = manager.getClosestPlayer(enemy->GetPosition())) {
-                enemy->SetTarget(target->GetPosition());
+        PlayerInput input = PollPlayerInput();
+        pendingInteract = pendingInteract || input.interact;
+
+        // Run as many fixed ticks as the elapsed frame time covers
+        int ticks = timestep.Advance(GetFrameTime());
+        for (int tick = 0; tick < ticks; tick++) {
+            PlayerInput tickInput = input;
+            tickInput.interact = pendingInteract;
+            pendingInteract = false;
+
+            if (recording) {
+                tickInput = inputLog.Append(tickInput);
             }
-        }
-        manager.addWaitingEntities();
-        // Update all entities (movement, AI, etc)
-        manager.updateEntities(deltaTime);
-        // Check collisions (spatial hash + layer filtering)
-        manager.checkCollisions();
 
-        // Remove dead entities
-        manager.deleteDeadEntities();
+            session.Tick(timestep.GetTickDuration(), tickInput);
 
-        // Check if enemy is still alive
-        hasActiveEnemy = !manager.getEnemies().empty();
+            recordedTotals.totalCandidatePairs += manager.getFrameStats().candidatePairs;
+            recordedTotals.totalContacts += manager.getFrameStats().contacts;
+        }
 
         // Draw
         BeginDrawing();
         ClearBackground(DARKGRAY);
 
         // Draw all entities
-        manager.drawEntities();
+        manager.drawEntities(timestep.GetAlpha());
 
         // Draw crosshair at mouse position
         Vector2 mousePos = GetMousePosition();
@@ -129,5 +135,13 @@ int main(void)
     // De-Initialization
     CloseWindow();
 
+    if (recording) {
+        recordedTotals.finalEntityCount = static_cast<uint32_t>(manager.getEntities().size());
+        inputLog.SetSummary(recordedTotals);
+        if (inputLog.Save(recordPath)) {
+            Logger::Info("Recorded ", inputLog.GetTickCount(), " ticks to ", recordPath);
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,351 @@
+// Headless simulation runner: steps EntityManager at a fixed dt with scripted
+// player input and no window, then reports per-phase timings.
+//
+// Usage: push_on_headless [--ticks N] [--dt SECONDS] [--enemies N]
+//                         [--players N] [--workers N] [--cell-size PIXELS]
+//                         [--broadphase grid|sap|hgrid]
+//                         [--grid-mode rebuild|incremental] [--walls]
+//                         [--spawn-scale N]
+//        push_on_headless --replay FILE [--workers N] [--cell-size PIXELS]
+//                         [--broadphase grid|sap|hgrid]
+//                         [--grid-mode rebuild|incremental]
+//
+// --grid-mode picks how the grid backends (grid, hgrid) keep their cells:
+// rebuilt every frame, or updated only for entities that changed cells.
+//
+// --replay runs a log recorded by `push_on --record FILE` through the game's
+// own scenario and checks the entity count and contacts against it. Candidate
+// pair counts depend on the broad phase, so they are compared only when the
+// replay uses the grid the game records with. The scripted scenario's flags
+// (--ticks, --dt, --enemies, --players, --walls, --spawn-scale) are rejected
+// with it: the log fixes the run, and the game never places walls.
+//
+// --walls places a few fixed walls so enemies path through the flow field.
+//
+// --spawn-scale spawns enemies on the edge of an area N times the arena's
+// size around its centre, so they walk in from beyond the screen and pass
+// through every AI level-of-detail tier.
+#include "EntityManager.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "Gun.h"
+#include "Sword.h"
+#include "GunBullet.h"
+#include "SwordSwing.h"
+#include "SwordSlam.h"
+#include "ObjectPool.h"
+#include "PlayerInput.h"
+#include "FixedTimestep.h"
+#include "GameSession.h"
+#include "InputLog.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+struct HeadlessConfig {
+    int ticks = 3600;
+    float deltaTime = 1.0f / 60.0f;
+    int enemies = 200;
+    int players = 1;
+    unsigned workers = 0;
+    float cellSize = 0.0f;  // 0 = EntityManager default
+    SpatialHashMode gridMode = SpatialHashMode::Rebuild;
+    bool gridModeSet = false;
+    BroadphaseType broadphase = BroadphaseType::Grid;
+    bool walls = false;
+    float spawnScale = 1.0f;  // Enemy spawn area relative to the arena
+    std::string replayPath;
+    const char* scenarioArg = nullptr;  // Last scenario-only flag given (not valid with --replay)
+};
+
+struct PhaseTotals {
+    double targetingMs = 0.0;
+    double spawnMs = 0.0;
+    double updateMs = 0.0;
+    double collisionMs = 0.0;
+    double cleanupMs = 0.0;
+    double totalMs = 0.0;
+    double maxTickMs = 0.0;
+    size_t peakEntities = 0;
+    uint64_t candidatePairs = 0;
+    uint64_t contacts = 0;
+    uint64_t lodUpdates = 0;
+    uint64_t lodDeferred = 0;
+
+    void Add(const FrameStats& stats) {
+        targetingMs += stats.targetingMs;
+        spawnMs += stats.spawnMs;
+        updateMs += stats.updateMs;
+        collisionMs += stats.collisionMs;
+        cleanupMs += stats.cleanupMs;
+        totalMs += stats.TotalMs();
+        maxTickMs = std::max(maxTickMs, stats.TotalMs());
+        peakEntities = std::max(peakEntities, stats.entityCount);
+        candidatePairs += stats.candidatePairs;
+        contacts += stats.contacts;
+        lodUpdates += stats.lodUpdates;
+        lodDeferred += stats.lodDeferred;
+    }
+};
+
+static bool ParseArgs(int argc, char** argv, HeadlessConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--walls") == 0) {
+            config.walls = true;
+            config.scenarioArg = arg;
+            continue;
+        }
+
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) {
+            Logger::Error("Missing value for ", arg);
+            return false;
+        }
+
+        // The scripted scenario's own settings; a replay takes them from its log
+        if (std::strcmp(arg, "--ticks") == 0 || std::strcmp(arg, "--dt") == 0 ||
+            std::strcmp(arg, "--enemies") == 0 || std::strcmp(arg, "--players") == 0 ||
+            std::strcmp(arg, "--spawn-scale") == 0) {
+            config.scenarioArg = arg;
+        }
+
+        if (std::strcmp(arg, "--ticks") == 0) config.ticks = std::atoi(value);
+        else if (std::strcmp(arg, "--dt") == 0) config.deltaTime = static_cast<float>(std::atof(value));
+        else if (std::strcmp(arg, "--enemies") == 0) config.enemies = std::atoi(value);
+        else if (std::strcmp(arg, "--players") == 0) config.players = std::atoi(value);
+        else if (std::strcmp(arg, "--workers") == 0) config.workers = static_cast<unsigned>(std::atoi(value));
+        else if (std::strcmp(arg, "--replay") == 0) config.replayPath = value;
+        else if (std::strcmp(arg, "--cell-size") == 0) config.cellSize = static_cast<float>(std::atof(value));
+        else if (std::strcmp(arg, "--spawn-scale") == 0) config.spawnScale = static_cast<float>(std::atof(value));
+        else if (std::strcmp(arg, "--broadphase") == 0) {
+            if (std::strcmp(value, "grid") == 0) config.broadphase = BroadphaseType::Grid;
+            else if (std::strcmp(value, "sap") == 0) config.broadphase = BroadphaseType::SweepAndPrune;
+            else if (std::strcmp(value, "hgrid") == 0) config.broadphase = BroadphaseType::HierarchicalGrid;
+            else {
+                Logger::Error("Unknown broadphase: ", value);
+                return false;
+            }
+        } else if (std::strcmp(arg, "--grid-mode") == 0) {
+            if (std::strcmp(value, "rebuild") == 0) config.gridMode = SpatialHashMode::Rebuild;
+            else if (std::strcmp(value, "incremental") == 0) config.gridMode = SpatialHashMode::Incremental;
+            else {
+                Logger::Error("Unknown grid mode: ", value);
+                return false;
+            }
+            config.gridModeSet = true;
+        } else {
+            Logger::Error("Unknown argument: ", arg);
+            return false;
+        }
+        i++;
+    }
+    if (!config.replayPath.empty() && config.scenarioArg) {
+        // The game never places walls or spawns this scenario, so the
+        // replay would diverge for reasons that have nothing to do with
+        // determinism
+        Logger::Error(config.scenarioArg, " does not apply to --replay");
+        return false;
+    }
+    if (config.gridModeSet && config.broadphase == BroadphaseType::SweepAndPrune) {
+        Logger::Error("--grid-mode only applies to the grid and hgrid broadphases");
+        return false;
+    }
+    return config.ticks > 0 && config.deltaTime > 0.0f && config.players >= 0 && config.enemies >= 0 &&
+           config.spawnScale >= 1.0f;
+}
+
+// Spread enemies around the edge of the arena scaled about its centre,
+// deterministically by index
+static Vector2 EnemySpawnPosition(int index, float scale) {
+    float width = GameSession::ARENA_WIDTH * scale;
+    float height = GameSession::ARENA_HEIGHT * scale;
+    float left = (GameSession::ARENA_WIDTH - width) / 2.0f;
+    float top = (GameSession::ARENA_HEIGHT - height) / 2.0f;
+
+    float t = static_cast<float>((index * 7919) % 1000) / 1000.0f;
+    float perimeter = 2.0f * (width + height);
+    float d = t * perimeter;
+    if (d < width) return { left + d, top + 20.0f };
+    d -= width;
+    if (d < height) return { left + width - 20.0f, top + d };
+    d -= height;
+    if (d < width) return { left + width - d, top + height - 20.0f };
+    d -= width;
+    return { left + 20.0f, top + height - d };
+}
+
+// Two bars between the spawn edges and the centre, with gaps to path
+// through; the world bounds (and so the flow field grid) are already set
+static void PlaceWalls(EntityManager& manager) {
+    const Rectangle world = manager.getWorldBounds();
+    FlowField& field = manager.getFlowField();
+    field.SetBlocked({ 160.0f, 120.0f, world.width - 320.0f, 32.0f }, true);
+    field.SetBlocked({ 160.0f, world.height - 152.0f, world.width - 320.0f, 32.0f }, true);
+    field.SetBlocked({ 200.0f, 152.0f, 32.0f, world.height - 304.0f }, true);
+    field.SetBlocked({ world.width - 232.0f, 152.0f, 32.0f, world.height - 304.0f }, true);
+}
+
+static void SpawnEnemy(EntityManager& manager, int index, float spawnScale) {
+    auto enemy = std::make_unique<Enemy>(EnemySpawnPosition(index, spawnScale), 100.0f, false);
+    if (index % 2 == 0) {
+        enemy->EquipWeapon(std::make_unique<Gun>());
+    } else {
+        enemy->EquipWeapon(std::make_unique<Sword>());
+    }
+    manager.queueEntity(std::move(enemy));
+}
+
+// Scripted controls: each player circles the arena centre and fires at
+// the nearest enemy (or straight ahead when there is none)
+static PlayerInput ScriptedInput(const EntityManager& manager, const Player& player, int tick) {
+    PlayerInput input;
+    float phase = tick * 0.02f + player.GetPlayerNumber() * 1.5f;
+    input.movement = { std::cos(phase), std::sin(phase) };
+
+    Vector2 position = player.GetPosition();
+    Vector2 aim = { position.x + input.movement.x, position.y + input.movement.y };
+    float closestDistSq = -1.0f;
+    for (const Enemy* enemy : manager.getEnemies()) {
+        Vector2 enemyPos = enemy->GetPosition();
+        float dx = enemyPos.x - position.x;
+        float dy = enemyPos.y - position.y;
+        float distSq = dx * dx + dy * dy;
+        if (closestDistSq < 0.0f || distSq < closestDistSq) {
+            closestDistSq = distSq;
+            aim = enemyPos;
+        }
+    }
+    input.aimTarget = aim;
+    input.fire = true;
+    return input;
+}
+
+static void ReportTotals(const PhaseTotals& totals, int tickCount) {
+    double ticks = static_cast<double>(tickCount);
+    Logger::Info("  targeting  avg ", totals.targetingMs / ticks, " ms");
+    Logger::Info("  spawn      avg ", totals.spawnMs / ticks, " ms");
+    Logger::Info("  update     avg ", totals.updateMs / ticks, " ms");
+    Logger::Info("  collision  avg ", totals.collisionMs / ticks, " ms");
+    Logger::Info("  cleanup    avg ", totals.cleanupMs / ticks, " ms");
+    Logger::Info("  tick       avg ", totals.totalMs / ticks, " ms, max ", totals.maxTickMs, " ms");
+    Logger::Info("  peak entities ", totals.peakEntities, ", candidate pairs ", totals.candidatePairs,
+                 ", contacts ", totals.contacts);
+    Logger::Info("  ai lod     updates ", totals.lodUpdates, ", deferred ", totals.lodDeferred);
+}
+
+// Re-run a recorded session tick for tick; returns the process exit code
+static int RunReplay(EntityManager& manager, const std::string& path) {
+    InputLog log;
+    if (!log.Load(path)) {
+        return 1;
+    }
+
+    float deltaTime = FixedTimestep(log.GetTickRate()).GetTickDuration();
+    GameSession session(manager, log.GetSeed());
+    session.Start();
+
+    PhaseTotals totals;
+    for (uint32_t tick = 0; tick < log.GetTickCount(); tick++) {
+        session.Tick(deltaTime, log.Get(tick, 0));
+        totals.Add(manager.getFrameStats());
+    }
+
+    const InputLog::Summary& expected = log.GetSummary();
+    size_t finalEntities = manager.getEntities().size();
+    Logger::Info("Replay ", path, ": ", log.GetTickCount(), " ticks at ", log.GetTickRate(),
+                 " Hz, seed ", log.GetSeed(), ", workers=", manager.getWorkerCount(),
+                 ", broadphase=", manager.getBroadphaseName());
+    ReportTotals(totals, static_cast<int>(log.GetTickCount()));
+
+    // Both modes of the grid find the same candidate pairs; other backends don't
+    bool comparePairs = manager.getBroadphase() == BroadphaseType::Grid;
+    if (finalEntities != expected.finalEntityCount ||
+        (comparePairs && totals.candidatePairs != expected.totalCandidatePairs) ||
+        totals.contacts != expected.totalContacts) {
+        Logger::Error("Replay diverged: entities ", finalEntities, " (recorded ", expected.finalEntityCount,
+                      "), candidate pairs ", totals.candidatePairs, " (recorded ", expected.totalCandidatePairs,
+                      "), contacts ", totals.contacts, " (recorded ", expected.totalContacts, ")");
+        return 2;
+    }
+    Logger::Info("  replay matches the recording (", finalEntities, " entities)");
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    HeadlessConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        Logger::Error("Usage: push_on_headless [--ticks N] [--dt SECONDS] [--enemies N] [--players N] [--workers N] [--cell-size PIXELS] [--broadphase grid|sap|hgrid] [--grid-mode rebuild|incremental] [--walls] [--spawn-scale N] [--replay FILE]");
+        return 1;
+    }
+
+    Logger::SetLevel(LogLevel::INFO);
+
+    EntityManager& manager = EntityManager::getInstance();
+    manager.setWorkerCount(config.workers);
+    if (config.cellSize > 0.0f) {
+        manager.setBroadphaseCellSize(config.cellSize);
+    }
+    manager.setBroadphaseMode(config.gridMode);
+    manager.setBroadphase(config.broadphase);
+    manager.setWorldBounds({ 0.0f, 0.0f, GameSession::ARENA_WIDTH, GameSession::ARENA_HEIGHT });
+    manager.setAiLodView(GameSession::ARENA_WIDTH, GameSession::ARENA_HEIGHT);
+    if (config.walls) {
+        PlaceWalls(manager);
+    }
+
+    ObjectPool<GunBullet>::Instance().Reserve(1024);
+    ObjectPool<SwordSwing>::Instance().Reserve(64);
+    ObjectPool<SwordSlam>::Instance().Reserve(64);
+
+    if (!config.replayPath.empty()) {
+        return RunReplay(manager, config.replayPath);
+    }
+
+    for (int i = 0; i < config.players; i++) {
+        float x = GameSession::ARENA_WIDTH * (i + 1) / (config.players + 1);
+        auto player = std::make_unique<Player>(Vector2{ x, GameSession::ARENA_HEIGHT / 2.0f }, i);
+        player->EquipWeapon(std::make_unique<Gun>());
+        manager.queueEntity(std::move(player));
+    }
+
+    int spawned = 0;
+    for (; spawned < config.enemies; spawned++) {
+        SpawnEnemy(manager, spawned, config.spawnScale);
+    }
+
+    PhaseTotals totals;
+    for (int tick = 0; tick < config.ticks; tick++) {
+        for (Player* player : manager.getPlayers()) {
+            player->SetInput(ScriptedInput(manager, *player, tick));
+        }
+
+        manager.step(config.deltaTime);
+
+        totals.Add(manager.getFrameStats());
+
+        // Keep the enemy population topped up
+        for (size_t alive = manager.getEnemies().size(); alive < static_cast<size_t>(config.enemies); alive++) {
+            SpawnEnemy(manager, spawned++, config.spawnScale);
+        }
+    }
+
+    Logger::Info("Headless run: ", config.ticks, " ticks, dt=", config.deltaTime,
+                 ", players=", config.players, ", enemies=", config.enemies,
+                 ", workers=", manager.getWorkerCount(), ", broadphase=", manager.getBroadphaseName(),
+                 config.broadphase != BroadphaseType::SweepAndPrune
+                     ? (config.gridMode == SpatialHashMode::Incremental ? " (incremental)" : " (rebuild)")
+                     : "");
+    ReportTotals(totals, config.ticks);
+    Logger::Info("  enemies spawned ", spawned);
+    if (config.walls) {
+        Logger::Info("  flow field rebuilds ", manager.getFlowField().GetRebuildCount());
+    }
+
+    return 0;
+}